@@ -24,8 +24,62 @@ namespace Aes_cbc_4k {
 
 	struct Block_number { Genode::uint64_t value; };
 
-	void encrypt(Key const &, Block_number, Plaintext  const &, Ciphertext &);
-	void decrypt(Key const &, Block_number, Ciphertext const &, Plaintext  &);
+	/*
+	 * The functions keep the cipher state of the most recently used key.
+	 * They return false if the key could not be set up.
+	 */
+	bool encrypt(Key const &, Block_number, Plaintext  const &, Ciphertext &);
+	bool decrypt(Key const &, Block_number, Ciphertext const &, Plaintext  &);
+
+	class Key_context;
 }
 
+
+/**
+ * Key with precomputed cipher state
+ *
+ * Encrypting or decrypting a block with a plain 'Key' derives the AES key
+ * schedules and the ESSIV key anew, which costs more than processing the
+ * block itself. A 'Key_context' derives them once. The key schedules are
+ * stored within the object, so no heap is needed, which allows for using
+ * the context in components without libc.
+ */
+class Aes_cbc_4k::Key_context
+{
+	private:
+
+		/* storage of an 'AES_KEY' of the crypto library */
+		struct Key_schedule { alignas(16) unsigned char bytes[256]; };
+
+		Key_schedule _encrypt { };
+		Key_schedule _decrypt { };
+		Key_schedule _essiv   { };
+
+		bool _valid = false;
+
+		/*
+		 * Noncopyable
+		 */
+		Key_context(Key_context const &);
+		Key_context &operator = (Key_context const &);
+
+		bool _iv(Block_number, unsigned char (&)[16]);
+
+	public:
+
+		Key_context(Key const &);
+
+		~Key_context();
+
+		bool valid() const { return _valid; }
+
+		/**
+		 * Encrypt/decrypt block
+		 *
+		 * \return  false if the context is invalid
+		 */
+		bool encrypt(Block_number, Plaintext  const &, Ciphertext &);
+		bool decrypt(Block_number, Ciphertext const &, Plaintext  &);
+};
+
 #endif /* _AES_CBC_4K_H_ */
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <util/dictionary.h>
+#include <util/xml_node.h>
 
 /* local includes */
 #include <writer.h>
@@ -49,10 +50,17 @@ class Trace_recorder::Backend_base : Backends::Element
 		 ** Interface **
 		 ***************/
 
+		/**
+		 * Create writer for the backend node of a policy
+		 *
+		 * The backend node may carry output attributes such as 'compress'
+		 * and 'rotate_size' (see 'Output_config').
+		 */
 		virtual Writer_base &create_writer(Genode::Allocator &,
 		                                   Genode::Registry<Writer_base> &,
 		                                   Directory &,
-		                                   Directory::Path const &) = 0;
+		                                   Directory::Path const &,
+		                                   Genode::Xml_node const &) = 0;
 };
 
 #endif /* _BACKEND_H_ */
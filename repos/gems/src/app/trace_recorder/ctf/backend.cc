@@ -20,15 +20,15 @@ void Writer::start_iteration(Directory             &root,
                              Directory::Path const &path,
                              ::Subject_info  const &info)
 {
-	_file_path = Directory::join(path, info.thread_name());
+	_file_path = _output_path.next(root, Directory::join(path, info.thread_name()), "");
 
 	try {
-		_dst_file.construct(root, _file_path);
+		_dst_file.construct(root, _file_path, _encoder_ptr);
 
 		/* initialise packet header */
 		_packet_buffer.init_header(info);
 	}
-	catch (Append_file::Create_failed)  {
+	catch (Output_file::Create_failed)  {
 		error("Could not create file."); }
 }
 
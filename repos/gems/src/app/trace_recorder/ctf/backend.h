@@ -27,7 +27,6 @@ namespace Ctf {
 	using namespace Trace_recorder;
 
 	using Genode::Directory;
-	using Genode::Append_file;
 
 	using Buffer = Write_buffer<32*1024>;
 
@@ -40,13 +39,18 @@ class Ctf::Writer : public Trace_recorder::Writer_base
 {
 	private:
 		Buffer                     &_packet_buffer;
-		Constructible<Append_file>  _dst_file      { };
+		Lz4::Frame_encoder         *_encoder_ptr;
+		Output_path                 _output_path;
+		Constructible<Output_file>  _dst_file      { };
 		Directory::Path             _file_path     { };
 
 	public:
-		Writer(Genode::Registry<Writer_base> &registry, Buffer &packet_buffer)
+		Writer(Genode::Registry<Writer_base> &registry, Buffer &packet_buffer,
+		       Lz4::Frame_encoder *encoder_ptr, Output_config const &output_config)
 		: Writer_base(registry),
-		  _packet_buffer(packet_buffer)
+		  _packet_buffer(packet_buffer),
+		  _encoder_ptr(encoder_ptr),
+		  _output_path(output_config)
 		{ }
 
 		virtual void start_iteration(Directory &,
@@ -67,6 +71,7 @@ class Ctf::Backend : Trace_recorder::Backend_base
 		Metadata                    _metadata;
 
 		Buffer                      _packet_buf      { };
+		Shared_encoder              _encoder         { };
 
 	public:
 
@@ -79,7 +84,8 @@ class Ctf::Backend : Trace_recorder::Backend_base
 		Writer_base &create_writer(Genode::Allocator             &alloc,
 		                           Genode::Registry<Writer_base> &registry,
 		                           Directory                     &root,
-		                           Directory::Path        const  &path) override
+		                           Directory::Path        const  &path,
+		                           Genode::Xml_node       const  &node) override
 		{
 			/* copy metadata file while adapting clock declaration */
 			Directory::Path metadata_path { Directory::join(path, "metadata") };
@@ -88,7 +94,10 @@ class Ctf::Backend : Trace_recorder::Backend_base
 				_metadata.write_file(metadata_file);
 			}
 
-			return *new (alloc) Writer(registry, _packet_buf);
+			Output_config const config = Output_config::from_xml(node);
+
+			return *new (alloc) Writer(registry, _packet_buf,
+			                           _encoder.encoder(alloc, config), config);
 		}
 };
 
@@ -16,6 +16,7 @@
 
 /* local includes */
 #include <subject_info.h>
+#include <output_file.h>
 #include <ctf/packet_header.h>
 
 /* Genode includes */
@@ -64,12 +65,12 @@ class Ctf::Write_buffer
 			});
 		}
 
-		void write_to_file(Genode::Append_file &dst, Genode::Directory::Path const &path)
+		void write_to_file(Trace_recorder::Output_file &dst, Genode::Directory::Path const &path)
 		{
 			if (_header().empty())
 				return;
 
-			if (dst.append(_buffer, _header().total_length_bytes()) != Append_file::Append_result::OK)
+			if (dst.append(_buffer, _header().total_length_bytes()) != Trace_recorder::Output_file::Append_result::OK)
 				error("Write error for ", path);
 
 			_header().reset();
@@ -0,0 +1,271 @@
+/*
+ * \brief  Streaming encoder for the LZ4 frame format
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Data is compressed into independent blocks of 64 KiB with a greedy
+ * single-probe match finder, which favours speed over compression ratio as
+ * the trace recorder must keep up with the traced components. Each frame is
+ * followed by a skippable frame that holds the compressed and uncompressed
+ * size of the frame. By reading these index footers from the end of a file,
+ * a reader can locate any frame without decompressing the preceding ones.
+ * Files can be decompressed with the 'lz4 -d' tool, which ignores the
+ * skippable frames.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LZ4_H_
+#define _LZ4_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <util/noncopyable.h>
+#include <util/string.h>
+
+namespace Trace_recorder::Lz4 {
+
+	using namespace Genode;
+
+	class Frame_encoder;
+}
+
+
+class Trace_recorder::Lz4::Frame_encoder : Noncopyable
+{
+	public:
+
+		static constexpr size_t BLOCK_SIZE = 64*1024;
+
+		/* magic number of the index footer within its skippable frame */
+		static constexpr uint32_t INDEX_MAGIC = 0x58444e49; /* "INDX" */
+
+	private:
+
+		static constexpr uint32_t FRAME_MAGIC     = 0x184d2204;
+		static constexpr uint32_t SKIPPABLE_MAGIC = 0x184d2a50;
+
+		static constexpr size_t HASH_LOG      = 12;
+		static constexpr size_t MIN_MATCH     = 4;
+		static constexpr size_t MFLIMIT       = 12;
+		static constexpr size_t LAST_LITERALS = 5;
+
+		static constexpr size_t MAX_COMPRESSED = BLOCK_SIZE + BLOCK_SIZE/255 + 16;
+
+		uint8_t  _block[BLOCK_SIZE]                { };
+		uint8_t  _compressed[4 + MAX_COMPRESSED]   { };
+		uint16_t _table[1 << HASH_LOG]             { };
+		size_t   _block_len                        { 0 };
+		uint64_t _raw_bytes                        { 0 };
+		uint64_t _frame_bytes                      { 0 };
+
+		static uint32_t _read32(uint8_t const *p)
+		{
+			return (uint32_t)p[0] | (uint32_t)p[1] << 8
+			     | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+		}
+
+		static void _write32(uint8_t *p, uint32_t v)
+		{
+			for (unsigned i = 0; i < 4; i++)
+				p[i] = (uint8_t)(v >> (8*i));
+		}
+
+		static uint32_t _rotl(uint32_t v, unsigned n) { return (v << n) | (v >> (32 - n)); }
+
+		/**
+		 * xxHash32 of a short input, used for the frame-descriptor checksum
+		 */
+		static uint32_t _xxh32(uint8_t const *p, size_t len)
+		{
+			uint32_t const P1 = 2654435761u, P2 = 2246822519u, P3 = 3266489917u,
+			               P4 =  668265263u, P5 =  374761393u;
+
+			uint32_t h = P5 + (uint32_t)len;
+			for (; len >= 4; len -= 4, p += 4)
+				h = _rotl(h + _read32(p)*P3, 17)*P4;
+
+			for (; len; len--, p++)
+				h = _rotl(h + (*p)*P5, 11)*P1;
+
+			h ^= h >> 15; h *= P2;
+			h ^= h >> 13; h *= P3;
+			h ^= h >> 16;
+			return h;
+		}
+
+		static void _write_length(uint8_t *&op, size_t len)
+		{
+			for (; len >= 255; len -= 255)
+				*op++ = 255;
+			*op++ = (uint8_t)len;
+		}
+
+		static void _write_sequence(uint8_t *&op, uint8_t const *literals, size_t num_literals,
+		                            size_t offset, size_t match_len)
+		{
+			size_t const ml = match_len ? match_len - MIN_MATCH : 0;
+
+			*op++ = (uint8_t)((min(num_literals, (size_t)15) << 4) | min(ml, (size_t)15));
+
+			if (num_literals >= 15)
+				_write_length(op, num_literals - 15);
+
+			memcpy(op, literals, num_literals);
+			op += num_literals;
+
+			if (!match_len)
+				return;
+
+			*op++ = (uint8_t)offset;
+			*op++ = (uint8_t)(offset >> 8);
+
+			if (ml >= 15)
+				_write_length(op, ml - 15);
+		}
+
+		/**
+		 * Compress block into '_compressed' behind the block-size field
+		 *
+		 * \return  size of the compressed block
+		 */
+		size_t _compress_block()
+		{
+			uint8_t const * const src = _block;
+			size_t          const n   = _block_len;
+			uint8_t              *op  = _compressed + 4;
+
+			size_t anchor = 0;
+
+			if (n > MFLIMIT) {
+
+				memset(_table, 0, sizeof(_table));
+
+				for (size_t ip = 0; ip < n - MFLIMIT; ) {
+
+					uint32_t const seq  = _read32(src + ip);
+					uint32_t const hash = (seq * 2654435761u) >> (32 - HASH_LOG);
+
+					size_t ref = _table[hash];
+					_table[hash] = (uint16_t)ip;
+
+					if (ref >= ip || _read32(src + ref) != seq) {
+						ip++;
+						continue;
+					}
+
+					/* extend match forward, keeping the last literals intact */
+					size_t len = MIN_MATCH;
+					while (ip + len < n - LAST_LITERALS && src[ref + len] == src[ip + len])
+						len++;
+
+					/* extend match backward into pending literals */
+					while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+						ip--; ref--; len++;
+					}
+
+					_write_sequence(op, src + anchor, ip - anchor, ip - ref, len);
+
+					ip    += len;
+					anchor = ip;
+				}
+			}
+			_write_sequence(op, src + anchor, n - anchor, 0, 0);
+
+			return (size_t)(op - (_compressed + 4));
+		}
+
+		void _flush_block(auto const &write_fn)
+		{
+			if (!_block_len)
+				return;
+
+			size_t const compressed_len = _compress_block();
+
+			/* store incompressible blocks uncompressed */
+			if (compressed_len >= _block_len) {
+				_write32(_compressed, (uint32_t)_block_len | 0x80000000u);
+				memcpy(_compressed + 4, _block, _block_len);
+				_write(write_fn, _compressed, 4 + _block_len);
+			} else {
+				_write32(_compressed, (uint32_t)compressed_len);
+				_write(write_fn, _compressed, 4 + compressed_len);
+			}
+			_block_len = 0;
+		}
+
+		void _write(auto const &write_fn, uint8_t const *src, size_t len)
+		{
+			write_fn((char const *)src, len);
+			_frame_bytes += len;
+		}
+
+	public:
+
+		/**
+		 * Start a new frame
+		 *
+		 * \param write_fn  functor called with '(char const *, size_t)' for
+		 *                  the compressed output
+		 */
+		void begin(auto const &write_fn)
+		{
+			_block_len   = 0;
+			_raw_bytes   = 0;
+			_frame_bytes = 0;
+
+			/* version 1, independent blocks, no checksums, 64 KiB blocks */
+			uint8_t header[7] { };
+			_write32(header, FRAME_MAGIC);
+			header[4] = 0x60;
+			header[5] = 0x40;
+			header[6] = (uint8_t)(_xxh32(header + 4, 2) >> 8);
+
+			_write(write_fn, header, sizeof(header));
+		}
+
+		void append(char const *src, size_t len, auto const &write_fn)
+		{
+			_raw_bytes += len;
+
+			while (len) {
+				size_t const n = min(len, BLOCK_SIZE - _block_len);
+				memcpy(_block + _block_len, src, n);
+				_block_len += n;
+				src        += n;
+				len        -= n;
+
+				if (_block_len == BLOCK_SIZE)
+					_flush_block(write_fn);
+			}
+		}
+
+		/**
+		 * Finish the frame and write its index footer
+		 */
+		void end(auto const &write_fn)
+		{
+			_flush_block(write_fn);
+
+			uint8_t end_mark[4] { };
+			_write(write_fn, end_mark, sizeof(end_mark));
+
+			/* skippable frame with the sizes of the frame */
+			uint8_t footer[28] { };
+			_write32(footer,      SKIPPABLE_MAGIC);
+			_write32(footer +  4, 20);
+			_write32(footer +  8, INDEX_MAGIC);
+			_write32(footer + 12, (uint32_t)_frame_bytes);
+			_write32(footer + 16, (uint32_t)(_frame_bytes >> 32));
+			_write32(footer + 20, (uint32_t)_raw_bytes);
+			_write32(footer + 24, (uint32_t)(_raw_bytes >> 32));
+			write_fn((char const *)footer, sizeof(footer));
+		}
+};
+
+#endif /* _LZ4_H_ */
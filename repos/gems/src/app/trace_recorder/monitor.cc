@@ -43,8 +43,10 @@ Trace_recorder::Monitor::Config Trace_recorder::Monitor::Config::from_xml(Xml_no
 }
 
 
-void Trace_recorder::Monitor::Attached_buffer::process_events(Trace_directory &trace_directory)
+unsigned Trace_recorder::Monitor::Attached_buffer::process_events(Trace_directory &trace_directory)
 {
+	size_t bytes = 0;
+
 	/* start iteration for every writer */
 	_writers.for_each([&] (Writer_base &writer) {
 		writer.start_iteration(trace_directory.root(),
@@ -57,6 +59,8 @@ void Trace_recorder::Monitor::Attached_buffer::process_events(Trace_directory &t
 		if (entry.length() == 0)
 			return true;
 
+		bytes += entry.length() + sizeof(size_t);
+
 		_writers.for_each([&] (Writer_base &writer) {
 			writer.process_event(entry.object<Trace_event_base>(), entry.length());
 		});
@@ -66,6 +70,8 @@ void Trace_recorder::Monitor::Attached_buffer::process_events(Trace_directory &t
 
 	/* end iteration for every writer */
 	_writers.for_each([&] (Writer_base &writer) { writer.end_iteration(); });
+
+	return (unsigned)min((bytes * 100) / _partition_size, (size_t)100);
 }
 
 
@@ -98,9 +104,26 @@ void Trace_recorder::Monitor::_with_session_policy(Trace::Subject_info const &in
 
 void Trace_recorder::Monitor::_handle_timeout()
 {
+	if (!_trace_directory.constructed() || !_period_ms)
+		return;
+
+	unsigned max_fill_percent = 0;
 	_trace_buffers.for_each([&] (Attached_buffer &buf) {
-		buf.process_events(*_trace_directory);
+		max_fill_percent = max(max_fill_percent, buf.process_events(*_trace_directory));
 	});
+
+	/*
+	 * Poll more often if a buffer partition filled up by more than a quarter
+	 * since the last round, which leaves headroom for bursts before the
+	 * producer overwrites unread entries. Back off if all buffers are almost
+	 * idle.
+	 */
+	if (max_fill_percent > 25)
+		_period_ms = max(_min_period_ms, max(1U, _period_ms / 2));
+	else if (max_fill_percent < 6)
+		_period_ms = min(_max_period_ms, _period_ms * 2);
+
+	_timer.trigger_once(_period_ms * 1000);
 }
 
 
@@ -170,7 +193,8 @@ void Trace_recorder::Monitor::start(Xml_node const &config)
 			                                                        _env,
 			                                                        _trace->buffer(id),
 			                                                        info,
-			                                                        id);
+			                                                        id,
+			                                                        buffer_size);
 
 			/* create and register writers at trace buffer */
 			session_policy.for_each_sub_node([&] (Xml_node const &node) {
@@ -180,7 +204,8 @@ void Trace_recorder::Monitor::start(Xml_node const &config)
 							backend.create_writer(_alloc,
 							                      buffer.writers(),
 							                      _trace_directory->root(),
-							                      _trace_directory->subject_path(buffer.info()));
+							                      _trace_directory->subject_path(buffer.info()),
+							                      node);
 							return true;
 						},
 						[&] /* no_match */ { return false; }
@@ -206,13 +231,22 @@ void Trace_recorder::Monitor::start(Xml_node const &config)
 	else
 		period_ms = config.attribute_value("period_ms", period_ms);
 
-	_timer.trigger_periodic(period_ms * 1000);
+	/*
+	 * A period of 0 disables polling, adapting the period must never get
+	 * there, which would stop the recording for good.
+	 */
+	_max_period_ms = period_ms;
+	_min_period_ms = max(1U, min(config.attribute_value("min_period_ms", period_ms), period_ms));
+	_period_ms     = period_ms;
+
+	if (_period_ms)
+		_timer.trigger_once(_period_ms * 1000);
 }
 
 
 void Trace_recorder::Monitor::stop()
 {
-	_timer.trigger_periodic(0);
+	_period_ms = 0;
 
 	_trace_buffers.for_each([&] (Attached_buffer &buf) {
 
@@ -222,6 +256,10 @@ void Trace_recorder::Monitor::stop()
 		/* read remaining events from buffers */
 		buf.process_events(*_trace_directory);
 
+		if (buf.lost_entries())
+			warning(buf.info().session_label(), " -> ", buf.info().thread_name(),
+			        ": lost ", buf.lost_entries(), " entries in total");
+
 		/* destroy writers */
 		buf.writers().for_each([&] (Writer_base &writer) {
 			destroy(_alloc, &writer); });
@@ -74,6 +74,7 @@ class Trace_recorder::Monitor
 
 				Env                               &_env;
 				Attached_dataspace                 _ds;
+				size_t                      const  _partition_size;
 				Trace_buffer                       _buffer;
 				Registry<Attached_buffer>::Element _element;
 				Subject_info                       _info;
@@ -86,17 +87,27 @@ class Trace_recorder::Monitor
 				                Genode::Env                  &env,
 				                Genode::Dataspace_capability ds,
 				                Trace::Subject_info    const &info,
-				                Trace::Subject_id            id)
+				                Trace::Subject_id            id,
+				                Trace::Buffer_size           size)
 				:
 					_env(env),
 					_ds(env.rm(), ds),
+					_partition_size(max(size.num_bytes / 2, (size_t)1)),
 					_buffer(*_ds.local_addr<Trace::Buffer>()),
 					_element(registry, *this),
 					_info(info),
 					_subject_id(id)
 				{ }
 
-				void process_events(Trace_directory &);
+				/**
+				 * Process new events
+				 *
+				 * \return  fill level of a buffer partition by the new events
+				 *          in percent
+				 */
+				unsigned process_events(Trace_directory &);
+
+				unsigned long long lost_entries() const { return _buffer.lost_entries(); }
 
 				Registry<Writer_base>   &writers()            { return _writers; }
 
@@ -114,6 +125,14 @@ class Trace_recorder::Monitor
 		Rtc::Connection                _rtc              { _env };
 		Timer::Connection              _timer            { _env };
 
+		/*
+		 * The polling period adapts to the event rate between 'min_period_ms'
+		 * and 'period_ms', see '_handle_timeout'
+		 */
+		unsigned                       _min_period_ms    { 0 };
+		unsigned                       _max_period_ms    { 0 };
+		unsigned                       _period_ms        { 0 };
+
 		struct Config
 		{
 			size_t session_ram;
@@ -0,0 +1,206 @@
+/*
+ * \brief  Output file with optional compression and size-based rotation
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _OUTPUT_FILE_H_
+#define _OUTPUT_FILE_H_
+
+/* local includes */
+#include <lz4.h>
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <os/vfs.h>
+#include <util/xml_node.h>
+
+namespace Trace_recorder {
+
+	using namespace Genode;
+
+	struct Output_config;
+	class  Output_path;
+	class  Output_file;
+	class  Shared_encoder;
+}
+
+
+/**
+ * Output attributes of a backend node, e.g., '<ctf compress="lz4"/>'
+ */
+struct Trace_recorder::Output_config
+{
+	bool            compress;
+	Number_of_bytes rotate_size;
+
+	static Output_config from_xml(Xml_node const &node)
+	{
+		return {
+			.compress    = (node.attribute_value("compress", String<8>()) == "lz4"),
+			.rotate_size = node.attribute_value("rotate_size", Number_of_bytes(0))
+		};
+	}
+};
+
+
+/**
+ * Path of the current output file of a writer
+ *
+ * With a 'rotate_size' configured, a writer continues with a new file
+ * whenever the current file reached this size. Files are numbered by
+ * inserting '.<n>' in front of the file-name extension.
+ */
+class Trace_recorder::Output_path : Noncopyable
+{
+	private:
+
+		Output_config const _config;
+		unsigned            _index { 0 };
+
+		Directory::Path _path(Directory::Path const &base, char const *ext) const
+		{
+			char const *lz4 = _config.compress ? ".lz4" : "";
+
+			if (_index)
+				return Directory::Path(base, ".", _index, ext, lz4);
+
+			return Directory::Path(base, ext, lz4);
+		}
+
+	public:
+
+		Output_path(Output_config const &config) : _config(config) { }
+
+		Output_config const &config() const { return _config; }
+
+		Directory::Path next(Directory &root, Directory::Path const &base, char const *ext)
+		{
+			Directory::Path path = _path(base, ext);
+
+			if (!_config.rotate_size)
+				return path;
+
+			try {
+				if (root.file_size(path) < _config.rotate_size)
+					return path;
+
+				_index++;
+			}
+			catch (Directory::Nonexistent_file) { }
+
+			return _path(base, ext);
+		}
+};
+
+
+/**
+ * Append-only output file
+ *
+ * If an encoder is given, the data appended during the lifetime of the
+ * object is written as one LZ4 frame. The frame is started with the first
+ * 'append' so that iterations without any output leave the file untouched.
+ */
+class Trace_recorder::Output_file : Noncopyable
+{
+	public:
+
+		using Create_failed = Append_file::Create_failed;
+		using Append_result = Append_file::Append_result;
+
+	private:
+
+		Append_file         _file;
+		Lz4::Frame_encoder *_encoder_ptr;
+		bool                _frame_started { false };
+		bool                _write_error   { false };
+
+		void _write(char const *src, size_t len)
+		{
+			if (_file.append(src, len) != Append_result::OK)
+				_write_error = true;
+		}
+
+		auto _write_fn() { return [&] (char const *src, size_t len) { _write(src, len); }; }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Create_failed
+		 */
+		Output_file(Directory &root, Directory::Path const &path,
+		            Lz4::Frame_encoder *encoder_ptr)
+		:
+			_file(root, path), _encoder_ptr(encoder_ptr)
+		{ }
+
+		~Output_file()
+		{
+			if (_encoder_ptr && _frame_started)
+				_encoder_ptr->end(_write_fn());
+		}
+
+		Append_result append(char const *src, size_t len)
+		{
+			_write_error = false;
+
+			if (!_encoder_ptr) {
+				_write(src, len);
+			} else {
+				if (!_frame_started) {
+					_encoder_ptr->begin(_write_fn());
+					_frame_started = true;
+				}
+				_encoder_ptr->append(src, len, _write_fn());
+			}
+
+			return _write_error ? Append_result::WRITE_ERROR : Append_result::OK;
+		}
+};
+
+
+/**
+ * LZ4 encoder shared by the writers of a backend
+ *
+ * As writers process their iterations one after another, a single encoder
+ * suffices. It is allocated on first use because it occupies more than
+ * 128 KiB.
+ */
+class Trace_recorder::Shared_encoder : Noncopyable
+{
+	private:
+
+		Allocator          *_alloc_ptr   { nullptr };
+		Lz4::Frame_encoder *_encoder_ptr { nullptr };
+
+	public:
+
+		~Shared_encoder()
+		{
+			if (_encoder_ptr)
+				destroy(*_alloc_ptr, _encoder_ptr);
+		}
+
+		Lz4::Frame_encoder *encoder(Allocator &alloc, Output_config const &config)
+		{
+			if (!config.compress)
+				return nullptr;
+
+			if (!_encoder_ptr) {
+				_alloc_ptr   = &alloc;
+				_encoder_ptr = new (alloc) Lz4::Frame_encoder();
+			}
+			return _encoder_ptr;
+		}
+};
+
+#endif /* _OUTPUT_FILE_H_ */
@@ -27,22 +27,19 @@ void Writer::start_iteration(Directory             &root,
                              Directory::Path const &path,
                              ::Subject_info  const &)
 {
-	/* write to '${path}.pcapng */
-	Path<Directory::MAX_PATH_LEN> pcap_file { path };
-	pcap_file.append(".pcapng");
-
-	_file_path = Directory::Path(pcap_file.string());
+	/* write to '${path}.pcapng', or '${path}.<n>.pcapng' after rotation */
+	_file_path = _output_path.next(root, path, ".pcapng");
 
 	/* append to file */
 	try {
-		_dst_file.construct(root, _file_path);
+		_dst_file.construct(root, _file_path, _encoder_ptr);
 
 		_interface_registry.clear();
 		_buffer.clear();
 		(void)_buffer.append<Section_header_block>(); /* header always fits in */
 		_empty_section = true;
 	}
-	catch (Append_file::Create_failed)  {
+	catch (Output_file::Create_failed)  {
 		error("Could not create file."); }
 }
 
@@ -130,7 +127,11 @@ void Writer::end_iteration()
 Trace_recorder::Writer_base &Backend::create_writer(Genode::Allocator             &alloc,
                                                     Genode::Registry<Writer_base> &registry,
                                                     Directory                     &,
-                                                    Directory::Path      const    &)
+                                                    Directory::Path      const    &,
+                                                    Genode::Xml_node     const    &node)
 {
-	return *new (alloc) Writer(registry, _interface_registry, _buffer, _ts_calibrator);
+	Output_config const config = Output_config::from_xml(node);
+
+	return *new (alloc) Writer(registry, _interface_registry, _buffer, _ts_calibrator,
+	                           _encoder.encoder(alloc, config), config);
 }
@@ -27,7 +27,6 @@ namespace Pcapng {
 	using namespace Trace_recorder;
 
 	using Genode::Directory;
-	using Genode::Append_file;
 
 	using Buffer = Write_buffer<32*1024>;
 
@@ -42,16 +41,21 @@ class Pcapng::Writer : public Trace_recorder::Writer_base
 		Interface_registry         &_interface_registry;
 		Buffer                     &_buffer;
 		Timestamp_calibrator const &_ts_calibrator;
-		Constructible<Append_file>  _dst_file      { };
+		Lz4::Frame_encoder         *_encoder_ptr;
+		Output_path                 _output_path;
+		Constructible<Output_file>  _dst_file      { };
 		Directory::Path             _file_path     { };
 		bool                        _empty_section { false };
 
 	public:
-		Writer(Genode::Registry<Writer_base> &registry, Interface_registry &interface_registry, Buffer &buffer, Timestamp_calibrator const &ts_calibrator)
+		Writer(Genode::Registry<Writer_base> &registry, Interface_registry &interface_registry, Buffer &buffer, Timestamp_calibrator const &ts_calibrator,
+		       Lz4::Frame_encoder *encoder_ptr, Output_config const &output_config)
 		: Writer_base(registry),
 		  _interface_registry(interface_registry),
 		  _buffer(buffer),
-		  _ts_calibrator(ts_calibrator)
+		  _ts_calibrator(ts_calibrator),
+		  _encoder_ptr(encoder_ptr),
+		  _output_path(output_config)
 		{ }
 
 		virtual void start_iteration(Directory &,
@@ -71,6 +75,7 @@ class Pcapng::Backend : Trace_recorder::Backend_base
 		Interface_registry          _interface_registry;
 		Buffer                      _buffer { };
 		Timestamp_calibrator const &_ts_calibrator;
+		Shared_encoder              _encoder { };
 
 	public:
 
@@ -83,7 +88,8 @@ class Pcapng::Backend : Trace_recorder::Backend_base
 		Writer_base &create_writer(Genode::Allocator             &,
 		                           Genode::Registry<Writer_base> &,
 		                           Directory                     &,
-		                           Directory::Path      const    &) override;
+		                           Directory::Path      const    &,
+		                           Genode::Xml_node     const    &) override;
 };
 
 
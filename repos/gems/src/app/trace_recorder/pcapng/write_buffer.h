@@ -14,6 +14,9 @@
 #ifndef _PCAPNG__WRITE_BUFFER_H_
 #define _PCAPNG__WRITE_BUFFER_H_
 
+/* local includes */
+#include <output_file.h>
+
 /* Genode includes */
 #include <util/attempt.h>
 #include <os/vfs.h>
@@ -61,12 +64,12 @@ class Pcapng::Write_buffer
 			return Ok();
 		}
 
-		void write_to_file(Genode::Append_file &dst, Directory::Path const &path)
+		void write_to_file(Trace_recorder::Output_file &dst, Directory::Path const &path)
 		{
 			if (_total_length == 0)
 				return;
 
-			if (dst.append(_buffer, _total_length) != Append_file::Append_result::OK)
+			if (dst.append(_buffer, _total_length) != Trace_recorder::Output_file::Append_result::OK)
 				error("Write error for ", path);
 
 			clear();
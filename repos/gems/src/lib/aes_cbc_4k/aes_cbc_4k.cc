@@ -12,6 +12,8 @@
  */
 
 #include <base/log.h>
+#include <base/mutex.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
 
 #include <aes_cbc_4k/aes_cbc_4k.h>
@@ -76,91 +78,129 @@ static void inline cleanup_crypto_data(T &t, S &s)
 	asm volatile(""::"r"(&t),"r"(&s):"memory");
 }
 
+static AES_KEY &aes_key(auto &schedule)
+{
+	static_assert(sizeof(schedule.bytes) >= sizeof(AES_KEY), "key schedule too small");
+	return *reinterpret_cast<AES_KEY *>(schedule.bytes);
+}
+
+
+Aes_cbc_4k::Key_context::Key_context(Key const &key)
+{
+	static_assert(sizeof(key.values) == 32, "Key size mismatch");
+
+	unsigned char const *key_values =
+		reinterpret_cast<unsigned char const *>(key.values);
+
+	Aes_cbc::Hash hash_of_key;
+	_valid = hash_key(key, hash_of_key)
+	      && !AES_set_encrypt_key(key_values, sizeof(key.values) * 8, &aes_key(_encrypt))
+	      && !AES_set_decrypt_key(key_values, sizeof(key.values) * 8, &aes_key(_decrypt))
+	      && !AES_set_encrypt_key(hash_of_key.values, sizeof(hash_of_key.values) * 8,
+	                              &aes_key(_essiv));
+
+	/* clean up crypto relevant data which stays otherwise on stack */
+	cleanup_crypto_data(hash_of_key);
+}
+
+
+Aes_cbc_4k::Key_context::~Key_context()
+{
+	cleanup_crypto_data(_encrypt, _decrypt);
+	cleanup_crypto_data(_essiv);
+}
+
+
 /**
  * Calculate initialization vector (IV) according to
  * "Encrypted salt-sector initialization vector" (ESSIV) algorithm
  * by Clemens Fruhwirth (July 18, 2005) published in
  * "New Methods in Hard Disk Encryption" paper.
  */
-static bool calculate_iv(Aes_cbc_4k::Key          const &key,
-                         Aes_cbc_4k::Block_number const &block,
-                         Aes_cbc::Iv                    &cipher_iv)
+bool Aes_cbc_4k::Key_context::_iv(Block_number block, unsigned char (&iv)[16])
 {
-	Aes_cbc::Hash hash_of_key;
-	if (!hash_key(key, hash_of_key))
-		return false;
-
-	AES_KEY key_for_iv;
-	if (AES_set_encrypt_key(hash_of_key.values, sizeof(hash_of_key.values) * 8,
-	                        &key_for_iv)) {
-		/* clean up crypto relevant data which stays otherwise on stack */
-		cleanup_crypto_data(hash_of_key);
-		return false;
-	}
-
 	Aes_cbc::Sn const plain  { block };
 	Aes_cbc::Iv       ivec   { };       /* zero IV */
 
-	static_assert(sizeof(plain.values) == sizeof(cipher_iv.values),
-	              "-plain- size vs -iv- size mismatch");
-
-	AES_cbc_encrypt(plain.values, cipher_iv.values, sizeof(plain.values),
-	                &key_for_iv, ivec.values, AES_ENCRYPT);
-
-	cleanup_crypto_data(hash_of_key, key_for_iv);
+	static_assert(sizeof(plain.values) == sizeof(iv), "-plain- size vs -iv- size mismatch");
 
+	AES_cbc_encrypt(plain.values, iv, sizeof(plain.values),
+	                &aes_key(_essiv), ivec.values, AES_ENCRYPT);
 	return true;
 }
 
-void Aes_cbc_4k::encrypt(Key const &key, Block_number const block_number,
-                         Plaintext const &plain, Ciphertext &cipher)
+
+bool Aes_cbc_4k::Key_context::encrypt(Block_number const block_number,
+                                      Plaintext const &plain, Ciphertext &cipher)
 {
 	static_assert(sizeof(plain.values)  == 4096, "Plain text size mismatch");
 	static_assert(sizeof(cipher.values) == 4096, "Cipher size mismatch");
-	static_assert(sizeof(key.values)    ==   32, "Key size mismatch");
-
-	AES_KEY aes_key;
-	if (AES_set_encrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
-		Genode::error("setting encrypt key");
-		return;
-	}
 
 	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
+	if (!_valid || !_iv(block_number, iv.values)) {
+		Genode::error("encryption of block ", block_number.value, " failed");
+		return false;
 	}
 
 	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(plain.values),
 	                reinterpret_cast<unsigned char *>(cipher.values),
-	                sizeof(cipher.values), &aes_key, iv.values, AES_ENCRYPT);
+	                sizeof(cipher.values), &aes_key(_encrypt), iv.values, AES_ENCRYPT);
 
-	/* clean up crypto relevant data which stays otherwise on stack */
-	cleanup_crypto_data(aes_key, iv);
+	cleanup_crypto_data(iv);
+	return true;
 }
 
-void Aes_cbc_4k::decrypt(Key const &key, Block_number const block_number,
-                         Ciphertext const &cipher, Plaintext &plain)
-{
-	AES_KEY aes_key;
-	if (AES_set_decrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
-		Genode::error("setting decrypt key");
-		return;
-	}
 
+bool Aes_cbc_4k::Key_context::decrypt(Block_number const block_number,
+                                      Ciphertext const &cipher, Plaintext &plain)
+{
 	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
+	if (!_valid || !_iv(block_number, iv.values)) {
+		Genode::error("decryption of block ", block_number.value, " failed");
+		return false;
 	}
 
 	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(cipher.values),
 	                reinterpret_cast<unsigned char *>(plain.values),
-	                sizeof(plain.values), &aes_key, iv.values, AES_DECRYPT);
+	                sizeof(plain.values), &aes_key(_decrypt), iv.values, AES_DECRYPT);
 
-	cleanup_crypto_data(aes_key, iv);
+	cleanup_crypto_data(iv);
+	return true;
+}
+
+
+/**
+ * Apply 'fn' to the context of 'key', which is retained for the next call
+ */
+static bool with_key_context(Aes_cbc_4k::Key const &key, auto const &fn)
+{
+	static Genode::Mutex                               mutex   { };
+	static Genode::Constructible<Aes_cbc_4k::Key_context> context { };
+	static Aes_cbc_4k::Key                             context_key { };
+
+	Genode::Mutex::Guard guard(mutex);
+
+	if (!context.constructed()
+	 || Genode::memcmp(context_key.values, key.values, sizeof(key.values))) {
+		context.construct(key);
+		Genode::memcpy(context_key.values, key.values, sizeof(key.values));
+	}
+
+	return fn(*context);
+}
+
+
+bool Aes_cbc_4k::encrypt(Key const &key, Block_number const block_number,
+                         Plaintext const &plain, Ciphertext &cipher)
+{
+	return with_key_context(key, [&] (Key_context &context) {
+		return context.encrypt(block_number, plain, cipher); });
+}
+
+
+bool Aes_cbc_4k::decrypt(Key const &key, Block_number const block_number,
+                         Ciphertext const &cipher, Plaintext &plain)
+{
+	return with_key_context(key, [&] (Key_context &context) {
+		return context.decrypt(block_number, cipher, plain); });
 }
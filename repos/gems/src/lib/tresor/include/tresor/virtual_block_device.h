@@ -32,6 +32,71 @@ class Tresor::Virtual_block_device : Noncopyable
 		class Write_vba;
 		class Extend_tree;
 
+	private:
+
+		/*
+		 * Cache of recently used inner nodes of the tree
+		 *
+		 * Consecutive VBAs share most of their branch, so walking the tree from the
+		 * root for each VBA reads the same inner nodes over and over again. Entries
+		 * are looked up by PBA and by the hash that the parent node expects, which
+		 * makes a hit as trustworthy as a read block that passed the hash check. As
+		 * PBAs are never overwritten with different content without the parent hash
+		 * changing, the cache needs no invalidation.
+		 */
+		class Node_cache : Noncopyable
+		{
+			private:
+
+				static constexpr unsigned NUM_ENTRIES = 32;
+
+				struct Entry
+				{
+					Physical_block_address pba { INVALID_PBA };
+					Hash hash { };
+					Type_1_node_block blk { };
+					uint64_t last_use { 0 };
+				};
+
+				Entry _entries[NUM_ENTRIES] { };
+				uint64_t _use_cnt { 0 };
+
+			public:
+
+				bool lookup(Physical_block_address pba, Hash const &hash, Type_1_node_block &blk)
+				{
+					for (Entry &entry : _entries)
+						if (entry.pba == pba && entry.hash == hash) {
+							blk = entry.blk;
+							entry.last_use = ++_use_cnt;
+							return true;
+						}
+					return false;
+				}
+
+				void insert(Physical_block_address pba, Hash const &hash, Type_1_node_block const &blk)
+				{
+					Entry *victim_ptr = &_entries[0];
+					for (Entry &entry : _entries) {
+						if (entry.pba == pba) {
+							victim_ptr = &entry;
+							break;
+						}
+						if (entry.last_use < victim_ptr->last_use)
+							victim_ptr = &entry;
+					}
+					*victim_ptr = { pba, hash, blk, ++_use_cnt };
+				}
+		};
+
+		Node_cache _node_cache { };
+
+	public:
+
+		bool execute(Read_vba &, Client_data_interface &, Block_io &, Crypto &);
+
+		bool execute(Write_vba &, Client_data_interface &, Block_io &, Free_tree &, Meta_tree &, Crypto &);
+
 		template <typename REQUEST, typename... ARGS>
 		bool execute(REQUEST &req, ARGS &&... args) { return req.execute(args...); }
 
@@ -140,10 +205,13 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 		Hash _hash { };
 		Block _blk { };
 		Tree_walk_pbas _new_pbas { };
+		bool _node_from_cache { false };
 		Generatable_request<Helper, State, Block_io::Read> _read_block { };
 		Generatable_request<Helper, State, Crypto::Decrypt> _decrypt_block { };
 
-		bool _check_and_decode_read_blk(bool &);
+		bool _check_and_decode_read_blk(Node_cache &, bool &);
+
+		void _read_node(Node_cache &, Physical_block_address, Hash const &, bool &);
 
 	public:
 
@@ -153,7 +221,7 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 
 		void print(Output &out) const { Genode::print(out, "read vba"); }
 
-		bool execute(Client_data_interface &, Block_io &, Crypto &);
+		bool execute(Node_cache &, Client_data_interface &, Block_io &, Crypto &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
@@ -203,13 +271,18 @@ class Tresor::Virtual_block_device::Write_vba : Noncopyable
 		Tree_walk_pbas _new_pbas { };
 		Number_of_blocks _num_blks { 0 };
 		Generation _free_gen { 0 };
+		bool _node_from_cache { false };
 		Generatable_request<Helper, State, Block_io::Read> _read_block { };
 		Generatable_request<Helper, State, Crypto::Decrypt> _decrypt_block { };
 		Generatable_request<Helper, State, Crypto::Encrypt> _encrypt_block { };
 		Generatable_request<Helper, State, Free_tree::Allocate_pbas> _alloc_pbas { };
 		Generatable_request<Helper, State, Block_io::Write> _write_block { };
 
-		bool _check_and_decode_read_blk(bool &);
+		bool _check_and_decode_read_blk(Node_cache &, bool &);
+
+		void _read_node(Node_cache &, Tree_level_index, Physical_block_address, Hash const &, bool &);
+
+		Hash const &_expected_hash(Tree_level_index);
 
 		void _set_new_pbas_and_num_blks_for_alloc();
 
@@ -227,7 +300,7 @@ class Tresor::Virtual_block_device::Write_vba : Noncopyable
 
 		void print(Output &out) const { Genode::print(out, "write vba"); }
 
-		bool execute(Client_data_interface &, Block_io &, Free_tree &, Meta_tree &, Crypto &);
+		bool execute(Node_cache &, Client_data_interface &, Block_io &, Free_tree &, Meta_tree &, Crypto &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
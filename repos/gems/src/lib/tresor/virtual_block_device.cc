@@ -17,8 +17,37 @@
 
 using namespace Tresor;
 
-bool Virtual_block_device::Read_vba::_check_and_decode_read_blk(bool &progress)
+
+bool Virtual_block_device::execute(Read_vba &req, Client_data_interface &client_data, Block_io &block_io, Crypto &crypto)
+{
+	return req.execute(_node_cache, client_data, block_io, crypto);
+}
+
+
+bool Virtual_block_device::execute(Write_vba &req, Client_data_interface &client_data, Block_io &block_io,
+                                   Free_tree &free_tree, Meta_tree &meta_tree, Crypto &crypto)
+{
+	return req.execute(_node_cache, client_data, block_io, free_tree, meta_tree, crypto);
+}
+
+
+void Virtual_block_device::Read_vba::_read_node(Node_cache &node_cache, Physical_block_address pba, Hash const &hash, bool &progress)
 {
+	if (node_cache.lookup(pba, hash, _t1_blks.items[_lvl])) {
+		_node_from_cache = true;
+		_helper.state = READ_BLK_SUCCEEDED;
+		progress = true;
+	} else
+		_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, pba, _blk);
+}
+
+
+bool Virtual_block_device::Read_vba::_check_and_decode_read_blk(Node_cache &node_cache, bool &progress)
+{
+	if (_node_from_cache) {
+		_node_from_cache = false;
+		return true;
+	}
 	Hash const *node_hash_ptr;
 	calc_hash(_blk, _hash);
 	if (_lvl) {
@@ -37,21 +66,23 @@ bool Virtual_block_device::Read_vba::_check_and_decode_read_blk(bool &progress)
 		_helper.mark_failed(progress, "check hash of read block");
 		return false;
 	}
-	if (_lvl)
+	if (_lvl) {
 		_t1_blks.items[_lvl].decode_from_blk(_blk);
-
+		node_cache.insert(_new_pbas.pbas[_lvl], _hash, _t1_blks.items[_lvl]);
+	}
 	return true;
 }
 
 
-bool Virtual_block_device::Read_vba::execute(Client_data_interface &client_data, Block_io &block_io, Crypto &crypto)
+bool Virtual_block_device::Read_vba::execute(Node_cache &node_cache, Client_data_interface &client_data, Block_io &block_io, Crypto &crypto)
 {
 	bool progress = false;
 	switch (_helper.state) {
 	case INIT:
 
 		_lvl = _attr.in_snap.max_level;
-		_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _attr.in_snap.pba, _blk);
+		_new_pbas.pbas[_lvl] = _attr.in_snap.pba;
+		_read_node(node_cache, _attr.in_snap.pba, _attr.in_snap.hash, progress);
 		if (VERBOSE_READ_VBA)
 			log("  load branch:\n    ", Branch_lvl_prefix("root: "), _attr.in_snap);
 		break;
@@ -59,7 +90,7 @@ bool Virtual_block_device::Read_vba::execute(Client_data_interface &client_data,
 	case READ_BLK: progress |= _read_block.execute(block_io); break;
 	case READ_BLK_SUCCEEDED:
 	{
-		if (!_check_and_decode_read_blk(progress))
+		if (!_check_and_decode_read_blk(node_cache, progress))
 			break;
 
 		if (!_lvl) {
@@ -77,7 +108,7 @@ bool Virtual_block_device::Read_vba::execute(Client_data_interface &client_data,
 		_lvl--;
 		_new_pbas.pbas[_lvl] = node.pba;
 		if (_lvl)
-			_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
+			_read_node(node_cache, node.pba, node.hash, progress);
 		else
 			if (node.gen == INITIAL_GENERATION) {
 				memset(&_blk, 0, BLOCK_SIZE);
@@ -364,8 +395,33 @@ void Virtual_block_device::Write_vba::_update_nodes_of_branch_of_written_vba()
 }
 
 
-bool Virtual_block_device::Write_vba::_check_and_decode_read_blk(bool &progress)
+Hash const &Virtual_block_device::Write_vba::_expected_hash(Tree_level_index lvl)
+{
+	if (lvl < _attr.in_out_snap.max_level)
+		return _t1_blks.node(_attr.in_vba, lvl + 1, _attr.in_vbd_degree).hash;
+
+	return _attr.in_out_snap.hash;
+}
+
+
+void Virtual_block_device::Write_vba::_read_node(Node_cache &node_cache, Tree_level_index lvl, Physical_block_address pba,
+                                                 Hash const &hash, bool &progress)
+{
+	if (node_cache.lookup(pba, hash, _t1_blks.items[lvl])) {
+		_node_from_cache = true;
+		_helper.state = READ_BLK_SUCCEEDED;
+		progress = true;
+	} else
+		_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, pba, _encoded_blk);
+}
+
+
+bool Virtual_block_device::Write_vba::_check_and_decode_read_blk(Node_cache &node_cache, bool &progress)
 {
+	if (_node_from_cache) {
+		_node_from_cache = false;
+		return true;
+	}
 	Hash *node_hash_ptr;
 	if (_lvl) {
 		calc_hash(_encoded_blk, _hash);
@@ -382,9 +438,13 @@ bool Virtual_block_device::Write_vba::_check_and_decode_read_blk(bool &progress)
 		_helper.mark_failed(progress, "check hash of read block");
 		return false;
 	}
-	if (_lvl)
+	if (_lvl) {
 		_t1_blks.items[_lvl].decode_from_blk(_encoded_blk);
+		Physical_block_address const pba { _lvl < _attr.in_out_snap.max_level ?
+			_t1_blks.node(_attr.in_vba, _lvl + 1, _attr.in_vbd_degree).pba : _attr.in_out_snap.pba };
 
+		node_cache.insert(pba, _hash, _t1_blks.items[_lvl]);
+	}
 	return true;
 }
 
@@ -421,14 +481,15 @@ void Virtual_block_device::Write_vba::_set_new_pbas_and_num_blks_for_alloc()
 }
 
 
-bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data, Block_io &block_io, Free_tree &free_tree, Meta_tree &meta_tree, Crypto &crypto)
+bool Virtual_block_device::Write_vba::execute(Node_cache &node_cache, Client_data_interface &client_data, Block_io &block_io,
+                                              Free_tree &free_tree, Meta_tree &meta_tree, Crypto &crypto)
 {
 	bool progress = false;
 	switch (_helper.state) {
 	case INIT:
 
 		_lvl = _attr.in_out_snap.max_level;
-		_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _attr.in_out_snap.pba, _encoded_blk);
+		_read_node(node_cache, _lvl, _attr.in_out_snap.pba, _attr.in_out_snap.hash, progress);
 		if (VERBOSE_WRITE_VBA)
 			log("  load branch:\n    ", Branch_lvl_prefix("root: "), _attr.in_out_snap);
 		break;
@@ -436,7 +497,7 @@ bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data
 	case READ_BLK: progress |= _read_block.execute(block_io); break;
 	case READ_BLK_SUCCEEDED:
 	{
-		if (!_check_and_decode_read_blk(progress))
+		if (!_check_and_decode_read_blk(node_cache, progress))
 			break;
 
 		Type_1_node &node = _t1_blks.node(_attr.in_vba, _lvl, _attr.in_vbd_degree);
@@ -444,7 +505,7 @@ bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data
 			log("    ", Branch_lvl_prefix("lvl ", _lvl, " node ", tree_node_index(_attr.in_vba, _lvl, _attr.in_vbd_degree), ": "), node);
 
 		if (_lvl > 1)
-			_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, node.pba, _encoded_blk);
+			_read_node(node_cache, _lvl - 1, node.pba, node.hash, progress);
 		else {
 			_set_new_pbas_and_num_blks_for_alloc();
 			if (_num_blks)
@@ -481,6 +542,8 @@ bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data
 
 		if (!_lvl)
 			_update_nodes_of_branch_of_written_vba();
+		else
+			node_cache.insert(_new_pbas.pbas[_lvl], _expected_hash(_lvl), _t1_blks.items[_lvl]);
 
 		if (_lvl < _attr.in_out_snap.max_level) {
 			_lvl++;
@@ -129,6 +129,11 @@ class Vfs_audit::File_system : public Vfs::File_system
 			return _root_dir.release(_expand(path).string(), ds);
 		}
 
+		bool dataspace_without_copy(char const *path) override
+		{
+			return _root_dir.dataspace_without_copy(_expand(path).string());
+		}
+
 		Open_result open(const char *path, unsigned int mode, Vfs::Vfs_handle **out, Genode::Allocator &alloc) override
 		{
 			_log(__func__, " ", path, " ", Genode::Hex(mode, Genode::Hex::OMIT_PREFIX, Genode::Hex::PAD));
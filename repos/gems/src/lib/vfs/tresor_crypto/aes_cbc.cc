@@ -14,6 +14,7 @@
 
 /* base includes */
 #include <base/log.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
 
 /* tresor includes */
@@ -33,9 +34,9 @@ struct Crypto : Tresor_crypto::Interface
 	struct Key_value_size_mismatch : Genode::Exception { };
 
 	struct {
-		uint32_t        id   { };
-		Aes_cbc_4k::Key key  { };
-		bool            used { false };
+		uint32_t                               id      { };
+		Constructible<Aes_cbc_4k::Key_context> context { };
+		bool                                   used    { false };
 	} keys [Slots::NUM_SLOTS];
 
 	struct {
@@ -136,13 +137,21 @@ struct Crypto : Tresor_crypto::Interface
 	             size_t             value_len) override
 	{
 		return apply_to_unused_key([&](auto &key_slot) {
-			if (value_len != sizeof(key_slot.key))
+			Aes_cbc_4k::Key key { };
+
+			if (value_len != sizeof(key))
 				return false;
 
-			if (!_slots.store(id))
+			/* derive the cipher state once instead of per block */
+			Genode::memcpy(key.values, value, sizeof(key));
+			key_slot.context.construct(key);
+			Genode::memset(key.values, 0, sizeof(key));
+
+			if (!key_slot.context->valid() || !_slots.store(id)) {
+				key_slot.context.destruct();
 				return false;
+			}
 
-			Genode::memcpy(key_slot.key.values, value, sizeof(key_slot.key));
 			key_slot.id   = id;
 			key_slot.used = true;
 
@@ -153,7 +162,7 @@ struct Crypto : Tresor_crypto::Interface
 	bool remove_key(uint32_t const id) override
 	{
 		return apply_key (id, [&] (auto &meta) {
-			Genode::memset(meta.key.values, 0, sizeof(meta.key.values));
+			meta.context.destruct();
 
 			meta.used = false;
 
@@ -188,7 +197,7 @@ struct Crypto : Tresor_crypto::Interface
 				/* paranoia */
 				static_assert(sizeof(plaintext) == sizeof(job.data), "size mismatch");
 
-				Aes_cbc_4k::encrypt(meta.key, block_number, plaintext, ciphertext);
+				meta.context->encrypt(block_number, plaintext, ciphertext);
 			});
 		});
 	}
@@ -262,7 +271,7 @@ struct Crypto : Tresor_crypto::Interface
 				/* paranoia */
 				static_assert(sizeof(ciphertext) == sizeof(job.data), "size mismatch");
 
-				Aes_cbc_4k::decrypt(meta.key, block_number, ciphertext, plaintext);
+				meta.context->decrypt(block_number, ciphertext, plaintext);
 
 				return true;
 			});
@@ -22,6 +22,7 @@
 
 /* local includes */
 #include "cpu_thread_component.h"
+#include "sample_histogram.h"
 #include "thread_list_change_handler.h"
 
 namespace Cpu_sampler {
@@ -64,6 +65,7 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		Allocator                               &_md_alloc;
 		Thread_list                             &_thread_list;
 		Thread_list_change_handler              &_thread_list_change_handler;
+		Sample_output                           &_sample_output;
 		Session_label                            _session_label;
 		unsigned int                             _next_thread_id = 0;
 		Capability<Cpu_session::Native_cpu>      _native_cpu_cap;
@@ -84,6 +86,7 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		                      Allocator                  &md_alloc,
 		                      Thread_list                &thread_list,
 		                      Thread_list_change_handler &thread_list_change_handler,
+		                      Sample_output              &sample_output,
 		                      char                 const *args);
 
 		/**
@@ -25,6 +25,7 @@ Cpu_sampler::Cpu_thread_component::Cpu_thread_component(
                                 Cpu_session_component   &cpu_session_component,
                                 Env                     &env,
                                 Allocator               &md_alloc,
+                                Sample_output           &sample_output,
                                 Pd_session_capability    pd,
                                 Cpu_session::Name const &name,
                                 Affinity::Location       affinity,
@@ -34,6 +35,7 @@ Cpu_sampler::Cpu_thread_component::Cpu_thread_component(
                                 unsigned int             thread_id)
 :
 	_cpu_session_component(cpu_session_component), _env(env), _md_alloc(md_alloc),
+	_sample_output(sample_output),
 	_parent_cpu_thread(
 		_cpu_session_component.parent_cpu_session()
 		                      .create_thread(pd, name, affinity, weight, utcb)),
@@ -74,12 +76,13 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 		_parent_cpu_client->pause();
 
 		Thread_state const thread_state = _parent_cpu_client->state();
-		if (thread_state.state == Thread_state::State::VALID)
-			_sample_buf[_sample_buf_index++] = thread_state.cpu.ip;
 
 		_parent_cpu_client->resume();
 
-		if (_sample_buf_index == SAMPLE_BUF_SIZE)
+		if (thread_state.state == Thread_state::State::VALID)
+			_samples.add(thread_state.cpu.ip);
+
+		if (_samples.full())
 			flush();
 
 		break;
@@ -92,29 +95,36 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 
 void Cpu_sampler::Cpu_thread_component::reset()
 {
-	_sample_buf_index = 0;
+	_samples.reset();
 }
 
 
 void Cpu_sampler::Cpu_thread_component::flush()
 {
-	if (_sample_buf_index == 0)
+	if (_samples.empty())
 		return;
 
+	if (_sample_output.write_samples(_label, _samples)) {
+		_samples.reset();
+		return;
+	}
+
 	if (!_log.constructed())
 		_log.construct(_env, _log_session_label);
 
 	/* number of hex characters + newline + '\0' */
 	using Sample = String<2 * sizeof(addr_t) + 1 + 1>;
 
-	for (unsigned int i = 0; i < _sample_buf_index; i++) {
+	/* one line per sample as expected by the evaluation scripts */
+	_samples.for_each([&] (addr_t ip, unsigned count) {
 
-		Sample const sample(Hex(_sample_buf[i], Hex::OMIT_PREFIX, Hex::PAD), "\n");
+		Sample const sample(Hex(ip, Hex::OMIT_PREFIX, Hex::PAD), "\n");
 
-		_log->write(sample.string());
-	}
+		for (unsigned i = 0; i < count; i++)
+			_log->write(sample.string());
+	});
 
-	_sample_buf_index = 0;
+	_samples.reset();
 }
 
 
@@ -21,6 +21,7 @@
 
 /* local includes */
 #include "cpu_session_component.h"
+#include "sample_histogram.h"
 
 namespace Cpu_sampler {
 	using namespace Genode;
@@ -32,13 +33,13 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 {
 	private:
 
-		enum { SAMPLE_BUF_SIZE = 1024 };
-
 		Cpu_session_component &_cpu_session_component;
 		Env                   &_env;
 
 		Allocator             &_md_alloc;
 
+		Sample_output         &_sample_output;
+
 		Cpu_session::Create_thread_result _parent_cpu_thread;
 		Constructible<Cpu_thread_client>  _parent_cpu_client;
 
@@ -47,8 +48,7 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 		Session_label          _label;
 		Session_label          _log_session_label;
 
-		Genode::addr_t         _sample_buf[SAMPLE_BUF_SIZE];
-		unsigned int           _sample_buf_index = 0;
+		Sample_histogram       _samples { };
 
 		Constructible<Log_connection> _log;
 
@@ -57,6 +57,7 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 		Cpu_thread_component(Cpu_session_component   &cpu_session_component,
 		                     Env                     &env,
 		                     Allocator               &md_alloc,
+		                     Sample_output           &sample_output,
 		                     Pd_session_capability    pd,
 		                     Cpu_session::Name const &name,
 		                     Affinity::Location       affinity,
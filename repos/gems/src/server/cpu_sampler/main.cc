@@ -19,6 +19,7 @@
 #include <base/attached_dataspace.h>
 #include <os/session_policy.h>
 #include <os/static_root.h>
+#include <os/vfs.h>
 #include <timer_session/connection.h>
 #include <util/list.h>
 
@@ -38,7 +39,7 @@ static constexpr bool verbose_sample_duration = true;
  ** Main program **
  ******************/
 
-struct Cpu_sampler::Main : Thread_list_change_handler
+struct Cpu_sampler::Main : Thread_list_change_handler, Sample_output
 {
 	Genode::Env            &env;
 	Genode::Heap            alloc;
@@ -52,31 +53,85 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 	unsigned int            max_sample_index;
 	Genode::uint64_t        timeout_us;
 
+	/*
+	 * In continuous mode, the sampling never ends and the aggregated
+	 * samples are flushed every 'flush_samples' samples
+	 */
+	bool                    continuous;
+	unsigned int            flush_samples;
+
+	using Path = Genode::Directory::Path;
+
+	Genode::Constructible<Genode::Root_directory> root_dir { };
+	Genode::Constructible<Genode::New_file>       folded_file { };
+
 
 	void handle_timeout()
 	{
+		bool const end_of_period = !continuous && (sample_index == max_sample_index);
+
+		bool const flush = end_of_period ||
+		                   (continuous && ((sample_index + 1) % flush_samples == 0));
+
 		auto lambda = [&] (Thread_element *cpu_thread_element) {
 
 			Cpu_thread_component *cpu_thread = cpu_thread_element->object();
 
 			cpu_thread->take_sample();
 
-			if (sample_index == max_sample_index)
+			if (flush)
 				cpu_thread->flush();
 		};
 
 		for_each_thread(selected_thread_list, lambda);
 
-		if (verbose_sample_duration && (sample_index == max_sample_index))
+		if (verbose_sample_duration && end_of_period)
 			Genode::log("sample period finished");
 
 		sample_index++;
 
-		if (sample_index == max_sample_index)
+		if (!continuous && (sample_index == max_sample_index))
 			timer.trigger_once(timeout_us);
 	}
 
 
+	/**
+	 * Sample_output interface
+	 *
+	 * Samples are written in the folded-stack format understood by
+	 * flame-graph tools, one line per sampled address. The elements of the
+	 * thread label form the outer frames.
+	 */
+	bool write_samples(Session_label const &thread,
+	                   Sample_histogram const &samples) override
+	{
+		if (!folded_file.constructed())
+			return false;
+
+		char frames[Session_label::capacity()] { };
+		{
+			char const *s = thread.string();
+			size_t      i = 0;
+			for (; *s && i + 1 < sizeof(frames); s++)
+				if (!Genode::strcmp(s, " -> ", 4)) {
+					frames[i++] = ';';
+					s += 3;
+				} else
+					frames[i++] = *s;
+		}
+
+		samples.for_each([&] (Genode::addr_t ip, unsigned count) {
+			Genode::String<Session_label::capacity() + 48> const
+				line(Genode::Cstring(frames), ";", Genode::Hex(ip), " ", count, "\n");
+
+			if (folded_file->append(line.string(), line.length() - 1)
+			    != Genode::New_file::Append_result::OK)
+				Genode::warning("failed to write samples of ", thread);
+		});
+		return true;
+	}
+
+
 	Signal_handler<Main> timeout_dispatcher =
 		{ env.ep(), *this, &Main::handle_timeout };
 
@@ -93,10 +148,44 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 		Genode::uint64_t sample_duration_s =
 			config.xml().attribute_value<Genode::uint64_t>("sample_duration_s", 10);
 
-		max_sample_index = ((sample_duration_s * 1000) / sample_interval_ms) - 1;
+		Genode::uint64_t flush_interval_s =
+			config.xml().attribute_value<Genode::uint64_t>("flush_interval_s", 10);
+
+		continuous = (sample_duration_s == 0);
+
+		max_sample_index = continuous ? 0 :
+			(unsigned)(((sample_duration_s * 1000) / sample_interval_ms) - 1);
+
+		flush_samples = Genode::max(1u,
+			(unsigned)((flush_interval_s * 1000) / sample_interval_ms));
 
 		timeout_us = sample_interval_ms * 1000;
 
+		/* flush samples of the previous configuration */
+		for_each_thread(selected_thread_list, [&] (Thread_element *e) {
+			e->object()->flush(); });
+
+		folded_file.destruct();
+
+		if (config.xml().attribute_value("output", Genode::String<16>("log")) == "folded") {
+
+			if (!root_dir.constructed())
+				config.xml().with_sub_node("vfs",
+					[&] (Genode::Xml_node const &vfs) { root_dir.construct(env, alloc, vfs); },
+					[&] { Genode::error("folded output requires a <vfs> config node"); });
+			else
+				config.xml().with_optional_sub_node("vfs", [&] (Genode::Xml_node const &vfs) {
+					root_dir->apply_config(vfs); });
+
+			Path const path = config.xml().attribute_value("file", Path("/samples.folded"));
+
+			if (root_dir.constructed()) {
+				try { folded_file.construct(*root_dir, path); }
+				catch (Genode::New_file::Create_failed) {
+					Genode::error("failed to create ", path); }
+			}
+		}
+
 		thread_list_changed();
 
 		if (verbose_sample_duration)
@@ -167,7 +256,7 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 	Main(Genode::Env &env)
 	: env(env),
 	  alloc(env.ram(), env.rm()),
-	  cpu_root(env.ep().rpc_ep(), env.ep().rpc_ep(), env, alloc, thread_list, *this),
+	  cpu_root(env.ep().rpc_ep(), env.ep().rpc_ep(), env, alloc, thread_list, *this, *this),
 	  config(env, "config")
 	{
 		/*
@@ -0,0 +1,110 @@
+/*
+ * \brief  Histogram of sampled instruction pointers
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SAMPLE_HISTOGRAM_H_
+#define _SAMPLE_HISTOGRAM_H_
+
+/* Genode includes */
+#include <base/session_label.h>
+#include <util/interface.h>
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	class Sample_histogram;
+	struct Sample_output;
+}
+
+
+/*
+ * Samples are aggregated per instruction pointer in an open-addressing hash
+ * table, which keeps the memory footprint of a thread constant regardless of
+ * the sampling duration and reduces the output to one line per hot address.
+ */
+class Cpu_sampler::Sample_histogram
+{
+	public:
+
+		enum { NUM_SLOTS = 1024 };
+
+	private:
+
+		struct Slot { addr_t ip; unsigned count; };
+
+		Slot     _slots[NUM_SLOTS] { };
+		unsigned _used  = 0;
+		unsigned _total = 0;
+
+		static unsigned _hash(addr_t ip)
+		{
+			uint64_t const h = (uint64_t)ip * 0x9e3779b97f4a7c15ULL;
+			return (unsigned)(h >> 32) % NUM_SLOTS;
+		}
+
+	public:
+
+		/**
+		 * Return true if the histogram should be flushed before adding samples
+		 */
+		bool full() const { return _used >= (NUM_SLOTS*3)/4; }
+
+		bool empty() const { return _total == 0; }
+
+		unsigned total() const { return _total; }
+
+		void add(addr_t ip)
+		{
+			for (unsigned i = _hash(ip); ; i = (i + 1) % NUM_SLOTS) {
+				Slot &slot = _slots[i];
+				if (slot.count && slot.ip != ip)
+					continue;
+
+				if (!slot.count) {
+					slot.ip = ip;
+					_used++;
+				}
+				slot.count++;
+				_total++;
+				return;
+			}
+		}
+
+		void for_each(auto const &fn) const
+		{
+			for (Slot const &slot : _slots)
+				if (slot.count)
+					fn(slot.ip, slot.count);
+		}
+
+		void reset()
+		{
+			for (Slot &slot : _slots)
+				slot = { };
+
+			_used = _total = 0;
+		}
+};
+
+
+struct Cpu_sampler::Sample_output : Interface
+{
+	/**
+	 * Write aggregated samples of a thread
+	 *
+	 * \return false if the samples are to be written to the LOG session
+	 *         of the thread
+	 */
+	virtual bool write_samples(Session_label const &thread,
+	                           Sample_histogram const &samples) = 0;
+};
+
+#endif /* _SAMPLE_HISTOGRAM_H_ */
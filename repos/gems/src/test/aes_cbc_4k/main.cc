@@ -77,7 +77,10 @@ struct Test::Main
 	                             Aes_cbc_4k::Plaintext const &plaintext,
 	                             Aes_cbc_4k::Block_number const &block_number)
 	{
-		Aes_cbc_4k::encrypt(key, block_number, plaintext, _ciphertext);
+		if (!Aes_cbc_4k::encrypt(key, block_number, plaintext, _ciphertext)) {
+			error("encryption failed");
+			return false;
+		}
 
 		if (_crypt_extern.size() < sizeof(_ciphertext.values)) {
 			error("ciphertext size mismatch: ",
@@ -85,7 +88,10 @@ struct Test::Main
 			return false;
 		}
 
-		Aes_cbc_4k::decrypt(key, block_number, _ciphertext, _decrypted_plaintext);
+		if (!Aes_cbc_4k::decrypt(key, block_number, _ciphertext, _decrypted_plaintext)) {
+			error("decryption failed");
+			return false;
+		}
 
 		/* compare decrypted ciphertext with original plaintext */
 		if (memcmp(plaintext.values, _decrypted_plaintext.values, sizeof(plaintext))) {
@@ -138,6 +144,34 @@ struct Test::Main
 			log("rounds=", test_rounds, ", cycles=", t_end - t_start,
 			    " cycles/rounds=", (t_end - t_start)/test_rounds);
 
+		/* the key context must produce the same ciphertext */
+		Aes_cbc_4k::Key_context context { key };
+		Aes_cbc_4k::Block_number const first_block {
+			config.xml().attribute_value("block_number",  0U) };
+
+		if (!context.encrypt(first_block, plaintext, _ciphertext)
+		 || memcmp(_ciphertext.values, cryptextern.values, sizeof(_ciphertext.values))) {
+			error("ciphertext by key context differs from external ciphertext");
+			return;
+		}
+
+		/* measure throughput with precomputed cipher state */
+		t_start = Trace::timestamp();
+		for (unsigned i = 0; i < test_rounds; i++) {
+			context.encrypt(block_number, plaintext, _ciphertext);
+			context.decrypt(block_number, _ciphertext, _decrypted_plaintext);
+			if (memcmp(plaintext.values, _decrypted_plaintext.values, sizeof(plaintext))) {
+				error("plaintext differs from ciphertext decrypted by key context");
+				return;
+			}
+			block_number.value ++;
+		}
+		t_end = Trace::timestamp();
+
+		if (test_rounds)
+			log("key context: rounds=", test_rounds, ", cycles=", t_end - t_start,
+			    " cycles/rounds=", (t_end - t_start)/test_rounds);
+
 		log("Test succeeded");
 	}
 };
@@ -0,0 +1,74 @@
+/*
+ * \brief  POSIX asynchronous I/O
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The layout of 'struct aiocb' matches the FreeBSD definition. Completion
+ * is reported via 'aio_error' and 'aio_suspend' only, the 'aio_sigevent'
+ * must specify SIGEV_NONE.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__LIBC_GENODE__AIO_H_
+#define _INCLUDE__LIBC_GENODE__AIO_H_
+
+#include <sys/cdefs.h>
+#include <sys/types.h>
+#include <sys/signal.h>
+
+/* return values of 'aio_cancel' */
+#define AIO_CANCELED    0x1
+#define AIO_NOTCANCELED 0x2
+#define AIO_ALLDONE     0x3
+
+/* operations of 'lio_listio' */
+#define LIO_NOP   0x0
+#define LIO_WRITE 0x1
+#define LIO_READ  0x2
+
+/* modes of 'lio_listio' */
+#define LIO_NOWAIT 0x0
+#define LIO_WAIT   0x1
+
+#define AIO_LISTIO_MAX 16
+
+struct __aiocb_private {
+	long  status;
+	long  error;
+	void *kernelinfo;
+};
+
+typedef struct aiocb {
+	int                     aio_fildes;     /* file descriptor */
+	off_t                   aio_offset;     /* file offset for I/O */
+	volatile void          *aio_buf;        /* I/O buffer */
+	size_t                  aio_nbytes;     /* number of bytes for I/O */
+	int                     __spare__[2];
+	void                   *__spare2__;
+	int                     aio_lio_opcode; /* LIO opcode */
+	int                     aio_reqprio;    /* ignored */
+	struct __aiocb_private  _aiocb_private;
+	struct sigevent         aio_sigevent;   /* SIGEV_NONE only */
+} aiocb_t;
+
+struct timespec;
+
+__BEGIN_DECLS
+
+int     aio_read(struct aiocb *);
+int     aio_write(struct aiocb *);
+int     aio_error(const struct aiocb *);
+ssize_t aio_return(struct aiocb *);
+int     aio_cancel(int, struct aiocb *);
+int     aio_suspend(const struct aiocb * const[], int, const struct timespec *);
+int     lio_listio(int, struct aiocb * const[], int, struct sigevent *);
+
+__END_DECLS
+
+#endif /* _INCLUDE__LIBC_GENODE__AIO_H_ */
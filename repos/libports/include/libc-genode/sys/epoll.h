@@ -0,0 +1,65 @@
+/*
+ * \brief  Linux-compatible epoll interface
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Only the readiness conditions EPOLLIN and EPOLLOUT are reported. Errors
+ * and hang-ups of sockets and pipes become visible as read readiness.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__LIBC_GENODE__SYS__EPOLL_H_
+#define _INCLUDE__LIBC_GENODE__SYS__EPOLL_H_
+
+#include <sys/cdefs.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <fcntl.h>
+
+#define EPOLL_CLOEXEC O_CLOEXEC
+
+#define EPOLLIN      0x00000001
+#define EPOLLPRI     0x00000002
+#define EPOLLOUT     0x00000004
+#define EPOLLERR     0x00000008
+#define EPOLLHUP     0x00000010
+#define EPOLLRDNORM  0x00000040
+#define EPOLLRDBAND  0x00000080
+#define EPOLLWRNORM  0x00000100
+#define EPOLLWRBAND  0x00000200
+#define EPOLLRDHUP   0x00002000
+#define EPOLLONESHOT (1U << 30)
+#define EPOLLET      (1U << 31)
+
+#define EPOLL_CTL_ADD 1
+#define EPOLL_CTL_DEL 2
+#define EPOLL_CTL_MOD 3
+
+typedef union epoll_data {
+	void     *ptr;
+	int       fd;
+	uint32_t  u32;
+	uint64_t  u64;
+} epoll_data_t;
+
+struct epoll_event {
+	uint32_t     events;
+	epoll_data_t data;
+};
+
+__BEGIN_DECLS
+
+int epoll_create(int size);
+int epoll_create1(int flags);
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+
+__END_DECLS
+
+#endif /* _INCLUDE__LIBC_GENODE__SYS__EPOLL_H_ */
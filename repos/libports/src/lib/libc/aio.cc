@@ -0,0 +1,768 @@
+/*
+ * \brief  POSIX asynchronous I/O
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Each request is a state machine that drives the asynchronous operations
+ * of the VFS handle behind the file descriptor, i.e., 'queue_read' and
+ * 'complete_read' or 'write'. In contrast to 'read' and 'write', which
+ * block the caller until the operation is complete, the requests are
+ * executed as asynchronous monitor jobs of the libc kernel whenever I/O
+ * progresses. Hence, a single thread can keep many file and socket
+ * requests in flight and wait for their completion via 'aio_suspend'.
+ *
+ * A VFS handle supports only one outstanding operation. Requests referring
+ * to the same file are therefore chained and executed in the order of
+ * their submission. The request state is accessed in the kernel context
+ * only, which serializes the execution with submission, cancellation, and
+ * the closing of the file.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+#include <aio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+/* internal includes */
+#include <internal/fd_alloc.h>
+#include <internal/file.h>
+#include <internal/init.h>
+#include <internal/monitor.h>
+#include <internal/plugin.h>
+#include <internal/errno.h>
+
+/* Genode includes */
+#include <base/id_space.h>
+#include <util/fifo.h>
+#include <vfs/file_system.h>
+
+using namespace Libc;
+
+namespace Libc {
+	struct Aio_request;
+
+	Vfs::Vfs_handle *vfs_handle_from_kernel(File_descriptor *);
+
+	bool aio_pending_from_kernel(File_descriptor *);
+}
+
+namespace { using Fn = Libc::Monitor::Function_result; }
+
+
+static Monitor           *_monitor_ptr;
+static Genode::Allocator *_alloc_ptr;
+
+
+static Libc::Monitor & monitor()
+{
+	struct Missing_call_of_init_aio : Genode::Exception { };
+	if (!_monitor_ptr)
+		throw Missing_call_of_init_aio();
+	return *_monitor_ptr;
+}
+
+
+struct Libc::Aio_request : Monitor::Function, Genode::Fifo<Aio_request>::Element,
+                           Genode::Noncopyable
+{
+	using Id_space = Genode::Id_space<Aio_request>;
+
+	enum class Op { READ, WRITE };
+
+	private:
+
+		enum class State { PENDING, READ, READ_QUEUED, READ_WAIT, WRITE, COMPLETE };
+
+		/*
+		 * Asynchronous jobs are never blocked upon, completion is observed
+		 * by polling the request state.
+		 */
+		struct Blockade : Libc::Blockade
+		{
+			void block()  override { }
+			void wakeup() override { _woken_up = true; }
+		};
+
+		aiocb const &_cb;
+
+		Op const _op;
+
+		File_descriptor * const _file;
+		Vfs::Vfs_handle * const _handle;
+
+		/* sockets and pipes are accessed at offset 0 */
+		Vfs::file_size const _offset;
+		bool           const _stream;
+
+		State _state;
+
+		bool _started = false;
+
+		/* number of bytes transferred */
+		size_t _count = 0;
+
+		ssize_t volatile _result;
+		int     volatile _error;
+
+		/* chain of requests referring to the same file */
+		Aio_request *_predecessor = nullptr;
+		Aio_request *_successor   = nullptr;
+
+		Blockade     _blockade { };
+		Monitor::Job _job      { *this, _blockade };
+
+		Id_space::Element const _elem;
+
+		/*
+		 * The seek offset of the VFS handle is shared with the synchronous
+		 * operations on the file descriptor and, thus, restored after each
+		 * step of the request.
+		 */
+		auto _with_seek(auto const &fn) -> decltype(fn())
+		{
+			Vfs::file_size const seek = _handle->seek();
+
+			_handle->seek(_stream ? 0 : (Vfs::file_offset)(_offset + _count));
+
+			auto const result = fn();
+
+			_handle->seek(seek);
+			return result;
+		}
+
+		/*
+		 * Successors are executed right after the completion of their
+		 * predecessor instead of waiting for the next execution of the
+		 * monitor jobs. The queue prevents recursion along long chains.
+		 */
+		static void _kick(Aio_request &request)
+		{
+			static Genode::Fifo<Aio_request> kicked;
+			static bool                      kicking = false;
+
+			kicked.enqueue(request);
+
+			if (kicking)
+				return;
+
+			kicking = true;
+			kicked.dequeue_all([] (Aio_request &r) { r.poll(); });
+			kicking = false;
+		}
+
+		void _finish(ssize_t result, int error)
+		{
+			Aio_request * const successor = _successor;
+
+			/* hand over successor to the predecessor of a canceled request */
+			if (_predecessor)
+				_predecessor->_successor = successor;
+			if (successor)
+				successor->_predecessor = _predecessor;
+
+			_predecessor = _successor = nullptr;
+
+			_state  = State::COMPLETE;
+			_result = result;
+			_error  = error;
+			_job.complete();
+
+			if (successor && !successor->_predecessor)
+				_kick(*successor);
+		}
+
+		void _store_id(aiocb &cb) const {
+			cb._aiocb_private.kernelinfo = (void *)_elem.id().value; }
+
+	public:
+
+		Aio_request(Id_space &id_space, aiocb &cb, Op op,
+		            File_descriptor &file, Vfs::file_size offset, bool stream)
+		:
+			_cb(cb), _op(op), _file(&file),
+			_handle(vfs_handle_from_kernel(&file)),
+			_offset(offset), _stream(stream),
+			_state(State::PENDING), _result(-1), _error(EINPROGRESS),
+			_elem(*this, id_space)
+		{
+			_store_id(cb);
+		}
+
+		/**
+		 * Constructor of a request that failed on submission
+		 */
+		Aio_request(Id_space &id_space, aiocb &cb, int error)
+		:
+			_cb(cb), _op(Op::READ), _file(nullptr), _handle(nullptr),
+			_offset(0), _stream(false),
+			_state(State::COMPLETE), _result(-1), _error(error),
+			_elem(*this, id_space)
+		{
+			_store_id(cb);
+			_job.complete();
+		}
+
+		static Id_space::Id id(aiocb const &cb) {
+			return { (unsigned long)cb._aiocb_private.kernelinfo }; }
+
+		bool belongs_to(aiocb const &cb) const { return &_cb == &cb; }
+
+		bool refers_to(File_descriptor const *file) const { return _file == file; }
+
+		/**
+		 * Return end offset of a write that is still in progress, or 0
+		 */
+		Vfs::file_size pending_write_end() const
+		{
+			if (_op != Op::WRITE || complete() || _stream)
+				return 0;
+
+			return _offset + _cb.aio_nbytes;
+		}
+
+		bool complete() const { return _state == State::COMPLETE; }
+
+		/* 'error' and 'result' may be called outside the kernel context */
+		int     error()  const { return _error; }
+		ssize_t result() const { return _result; }
+
+		bool cancelable() const
+		{
+			switch (_state) {
+			case State::PENDING:
+			case State::READ:
+			case State::READ_WAIT: return true;
+			case State::WRITE:     return _count == 0;
+			default:               return false;
+			}
+		}
+
+		void cancel() { _finish(-1, ECANCELED); }
+
+		Monitor::Job &job() { return _job; }
+
+		/**
+		 * Append request to the chain of its file and execute the first step
+		 */
+		void start(Id_space &id_space)
+		{
+			id_space.for_each<Aio_request>([&] (Aio_request &r) {
+				if (&r != this && r._started && r._file == _file
+				 && !r.complete() && !r._successor)
+					_predecessor = &r; });
+
+			if (_predecessor)
+				_predecessor->_successor = this;
+
+			_started = true;
+			poll();
+		}
+
+		/**
+		 * Execute request
+		 *
+		 * \return true if the request is complete
+		 */
+		bool poll()
+		{
+			if (!complete() && _job.execute())
+				_job.complete();
+
+			return complete();
+		}
+
+		/**
+		 * Monitor::Function interface
+		 */
+		Fn execute() override
+		{
+			using Read_result  = Vfs::File_io_service::Read_result;
+			using Write_result = Vfs::File_io_service::Write_result;
+
+			for (;;) {
+
+				switch (_state) {
+
+				case State::PENDING:
+
+					if (_predecessor)
+						return Fn::INCOMPLETE;
+
+					_state = (_op == Op::READ) ? State::READ : State::WRITE;
+					continue;
+
+				case State::READ:
+
+					if (!_with_seek([&] {
+						return _handle->fs().queue_read(_handle, _cb.aio_nbytes); }))
+						return Fn::INCOMPLETE;
+
+					_state = State::READ_QUEUED;
+					continue;
+
+				case State::READ_QUEUED:
+				{
+					Genode::Byte_range_ptr const dst { (char *)_cb.aio_buf,
+					                                   _cb.aio_nbytes };
+
+					Read_result const result = _with_seek([&] {
+						return _handle->fs().complete_read(_handle, dst, _count); });
+
+					switch (result) {
+					case Read_result::READ_QUEUED:
+						return Fn::INCOMPLETE;
+
+					case Read_result::READ_ERR_WOULD_BLOCK:
+						_handle->fs().notify_read_ready(_handle);
+						_state = State::READ_WAIT;
+						continue;
+
+					case Read_result::READ_ERR_INVALID: _finish(-1, EINVAL);              break;
+					case Read_result::READ_ERR_IO:      _finish(-1, EIO);                 break;
+					case Read_result::READ_OK:          _finish((ssize_t)_count, 0); break;
+					}
+					return Fn::COMPLETE;
+				}
+
+				case State::READ_WAIT:
+
+					if (!_handle->fs().read_ready(*_handle))
+						return Fn::INCOMPLETE;
+
+					_state = State::READ;
+					continue;
+
+				case State::WRITE:
+				{
+					if (_count == _cb.aio_nbytes) {
+						_finish((ssize_t)_count, 0);
+						return Fn::COMPLETE;
+					}
+
+					Genode::Const_byte_range_ptr const src {
+						(char const *)_cb.aio_buf + _count, _cb.aio_nbytes - _count };
+
+					size_t out_count = 0;
+
+					Write_result const result = _with_seek([&] {
+						return _handle->fs().write(_handle, src, out_count); });
+
+					switch (result) {
+					case Write_result::WRITE_ERR_WOULD_BLOCK:
+						return Fn::INCOMPLETE;
+
+					case Write_result::WRITE_ERR_INVALID:
+						_finish(-1, EINVAL);
+						return Fn::COMPLETE;
+
+					case Write_result::WRITE_ERR_IO:
+						_finish(-1, EIO);
+						return Fn::COMPLETE;
+
+					case Write_result::WRITE_OK:
+						break;
+					}
+
+					_count += out_count;
+
+					/* the VFS reports no write readiness, retry on I/O progress */
+					if (out_count == 0)
+						return Fn::INCOMPLETE;
+
+					continue;
+				}
+
+				case State::COMPLETE:
+					return Fn::COMPLETE;
+				}
+			}
+		}
+};
+
+
+static Aio_request::Id_space *_requests_ptr;
+
+
+static Aio_request::Id_space &requests()
+{
+	struct Missing_call_of_init_aio : Genode::Exception { };
+	if (!_requests_ptr)
+		throw Missing_call_of_init_aio();
+	return *_requests_ptr;
+}
+
+
+void Libc::init_aio(Genode::Allocator &alloc, Monitor &monitor,
+                    File_descriptor_allocator &fd_alloc)
+{
+	_requests_ptr = new (alloc) Aio_request::Id_space();
+	_alloc_ptr    = &alloc;
+	_monitor_ptr  = &monitor;
+	_fd_alloc_ptr = &fd_alloc;
+}
+
+
+/**
+ * Look up request submitted with control block 'cb'
+ */
+static Aio_request *lookup(aiocb const *cb)
+{
+	Aio_request *result = nullptr;
+
+	requests().apply<Aio_request>(Aio_request::id(*cb),
+		[&] (Aio_request &r) { if (r.belongs_to(*cb)) result = &r; },
+		[&] () { });
+
+	return result;
+}
+
+
+static void destroy(Aio_request &request)
+{
+	Genode::destroy(*_alloc_ptr, &request);
+}
+
+
+/**
+ * Create request for 'cb'
+ *
+ * \return  request, or nullptr if the submission failed with 'error'
+ */
+static Aio_request *create(aiocb &cb, Aio_request::Op op, int &error)
+{
+	using Op = Aio_request::Op;
+
+	auto failed = [&] (int e) -> Aio_request * { error = e; return nullptr; };
+
+	/* control block is reused without 'aio_return' */
+	if (Aio_request *old = lookup(&cb)) {
+		if (!old->complete())
+			return failed(EINVAL);
+		destroy(*old);
+	}
+
+	if (cb.aio_sigevent.sigev_notify != SIGEV_NONE || cb.aio_nbytes > SSIZE_MAX)
+		return failed(EINVAL);
+
+	File_descriptor * const fd = file_descriptor_allocator()->find_by_libc_fd(cb.aio_fildes);
+	if (!fd || !fd->plugin)
+		return failed(EBADF);
+
+	int const mode = fd->flags & O_ACCMODE;
+	if ((op == Op::READ && mode == O_WRONLY) || (op == Op::WRITE && mode == O_RDONLY))
+		return failed(EBADF);
+
+	File_descriptor * const file = fd->plugin->data_file(fd);
+	if (!file || (fd->flags & O_DIRECTORY))
+		return failed(EINVAL);
+
+	/* the offset is ignored for sockets */
+	bool const stream = (file != fd);
+	if (!stream && cb.aio_offset < 0)
+		return failed(EINVAL);
+
+	Vfs::file_size offset = stream ? 0 : (Vfs::file_size)cb.aio_offset;
+
+	/*
+	 * Like 'write', append to the end of the file, which includes the data
+	 * of writes submitted before but not yet completed.
+	 */
+	if (!stream && op == Op::WRITE && (fd->flags & O_APPEND)) {
+		struct stat st { };
+		if (::fstat(cb.aio_fildes, &st) == -1)
+			return failed(errno);
+
+		offset = (Vfs::file_size)st.st_size;
+		requests().for_each<Aio_request>([&] (Aio_request const &r) {
+			if (r.refers_to(file))
+				offset = Genode::max(offset, r.pending_write_end()); });
+	}
+
+	return new (*_alloc_ptr)
+		Aio_request(requests(), cb, op, *file, offset, stream);
+}
+
+
+/**
+ * Start requests and hand them over to the monitor
+ *
+ * All requests are started in one visit of the kernel context, which
+ * issues the first VFS operation of each request.
+ */
+static void start(Aio_request * const request[], unsigned num)
+{
+	monitor().monitor([&] {
+		for (unsigned i = 0; i < num; i++)
+			if (request[i] && !request[i]->complete())
+				request[i]->start(requests());
+		return Fn::COMPLETE;
+	});
+
+	bool pending = false;
+	for (unsigned i = 0; i < num; i++)
+		if (request[i] && !request[i]->complete()) {
+			monitor().monitor_async(request[i]->job());
+			pending = true;
+		}
+
+	if (pending)
+		monitor().trigger_monitor_examination();
+}
+
+
+static int submit(aiocb *cb, Aio_request::Op op)
+{
+	if (!cb)
+		return Errno(EINVAL);
+
+	int error = 0;
+	Aio_request * const request = create(*cb, op, error);
+	if (!request)
+		return Errno(error);
+
+	start(&request, 1);
+	return 0;
+}
+
+
+bool Libc::aio_pending_from_kernel(File_descriptor *file)
+{
+	if (!_requests_ptr)
+		return false;
+
+	bool pending = false;
+
+	requests().for_each<Aio_request>([&] (Aio_request &r) {
+
+		if (!r.refers_to(file) || r.complete())
+			return;
+
+		if (r.cancelable())
+			r.cancel();
+		else if (!r.poll())
+			pending = true;
+	});
+
+	return pending;
+}
+
+
+extern "C" int aio_read(struct aiocb *cb)
+{
+	return submit(cb, Aio_request::Op::READ);
+}
+
+
+extern "C" int aio_write(struct aiocb *cb)
+{
+	return submit(cb, Aio_request::Op::WRITE);
+}
+
+
+extern "C" int aio_error(const struct aiocb *cb)
+{
+	Aio_request * const request = cb ? lookup(cb) : nullptr;
+	if (!request)
+		return Errno(EINVAL);
+
+	/* make progress for callers that poll for completion */
+	if (!request->complete())
+		monitor().monitor([&] {
+			request->poll();
+			return Fn::COMPLETE;
+		});
+
+	return request->error();
+}
+
+
+extern "C" ssize_t aio_return(struct aiocb *cb)
+{
+	Aio_request * const request = cb ? lookup(cb) : nullptr;
+	if (!request || !request->complete())
+		return Errno(EINVAL);
+
+	ssize_t const result = request->result();
+	int     const error  = request->error();
+
+	cb->_aiocb_private.kernelinfo = nullptr;
+	destroy(*request);
+
+	if (result < 0)
+		return Errno(error);
+
+	return result;
+}
+
+
+extern "C" int aio_cancel(int libc_fd, struct aiocb *cb)
+{
+	if (cb && cb->aio_fildes != libc_fd)
+		return Errno(EINVAL);
+
+	File_descriptor * const fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+	if (!fd || !fd->plugin)
+		return Errno(EBADF);
+
+	File_descriptor * const file = fd->plugin->data_file(fd);
+
+	int result = AIO_ALLDONE;
+
+	auto cancel = [&] (Aio_request &r)
+	{
+		if (r.complete())
+			return;
+
+		if (!r.cancelable()) {
+			result = AIO_NOTCANCELED;
+			return;
+		}
+
+		r.cancel();
+
+		if (result == AIO_ALLDONE)
+			result = AIO_CANCELED;
+	};
+
+	monitor().monitor([&] {
+		if (cb) {
+			if (Aio_request * const request = lookup(cb))
+				cancel(*request);
+		} else if (file) {
+			requests().for_each<Aio_request>([&] (Aio_request &r) {
+				if (r.refers_to(file))
+					cancel(r); });
+		}
+		return Fn::COMPLETE;
+	});
+
+	return result;
+}
+
+
+#define __SYS_(ret_type, name, args, body) \
+	extern "C" {\
+	ret_type  __sys_##name args body \
+	ret_type __libc_##name args __attribute__((alias("__sys_" #name))); \
+	ret_type       _##name args __attribute__((alias("__sys_" #name))); \
+	ret_type          name args __attribute__((alias("__sys_" #name))); \
+	} \
+
+
+__SYS_(int, aio_suspend, (const struct aiocb * const list[], int nent,
+                          const struct timespec *timeout),
+{
+	if (nent < 0)
+		return Errno(EINVAL);
+
+	/* a zero timeout polls the requests once */
+	bool const poll_only = timeout && !timeout->tv_sec && !timeout->tv_nsec;
+
+	uint64_t const timeout_ms = timeout
+	                          ? (uint64_t)timeout->tv_sec*1000
+	                            + ((uint64_t)timeout->tv_nsec + 999'999)/1'000'000
+	                          : 0;
+
+	bool done = false;
+
+	/*
+	 * The requests are executed by the monitor function itself because
+	 * the execution order of the monitor jobs is undefined.
+	 */
+	monitor().monitor([&] {
+		for (int i = 0; i < nent; i++) {
+			if (!list[i])
+				continue;
+
+			/* requests already retrieved via 'aio_return' are complete */
+			Aio_request * const request = lookup(list[i]);
+			if (!request || request->poll())
+				done = true;
+		}
+		return (done || poll_only) ? Fn::COMPLETE : Fn::INCOMPLETE;
+	}, timeout_ms);
+
+	if (!done)
+		return Errno(EAGAIN);
+
+	return 0;
+})
+
+
+extern "C" int lio_listio(int mode, struct aiocb * const list[], int nent,
+                          struct sigevent *sig)
+{
+	if ((mode != LIO_WAIT && mode != LIO_NOWAIT) || nent < 0 || nent > AIO_LISTIO_MAX)
+		return Errno(EINVAL);
+
+	if (mode == LIO_NOWAIT && sig && sig->sigev_notify != SIGEV_NONE)
+		return Errno(EINVAL);
+
+	using Op = Aio_request::Op;
+
+	Aio_request *request[AIO_LISTIO_MAX] { };
+
+	bool failed = false;
+
+	for (int i = 0; i < nent; i++) {
+
+		aiocb * const cb = list[i];
+		if (!cb || cb->aio_lio_opcode == LIO_NOP)
+			continue;
+
+		/*
+		 * A control block still in use by a request in flight must not be
+		 * taken over by a failed submission, which would detach the running
+		 * request from the control block.
+		 */
+		if (Aio_request * const old = lookup(cb)) {
+			if (!old->complete()) {
+				failed = true;
+				continue;
+			}
+		}
+
+		int error = EINVAL;
+
+		switch (cb->aio_lio_opcode) {
+		case LIO_READ:  request[i] = create(*cb, Op::READ,  error); break;
+		case LIO_WRITE: request[i] = create(*cb, Op::WRITE, error); break;
+		}
+
+		/* report submission error via 'aio_error' */
+		if (!request[i]) {
+			request[i] = new (*_alloc_ptr) Aio_request(requests(), *cb, error);
+			failed = true;
+		}
+	}
+
+	start(request, (unsigned)nent);
+
+	if (mode == LIO_WAIT) {
+		monitor().monitor([&] {
+			bool complete = true;
+			for (int i = 0; i < nent; i++)
+				if (request[i] && !request[i]->poll())
+					complete = false;
+			return complete ? Fn::COMPLETE : Fn::INCOMPLETE;
+		});
+
+		for (int i = 0; i < nent; i++)
+			if (request[i] && request[i]->error())
+				failed = true;
+	}
+
+	if (failed)
+		return Errno(EIO);
+
+	return 0;
+}
@@ -0,0 +1,546 @@
+/*
+ * \brief  epoll implementation
+ * \author agent
+ * \date   2026-10-19
+ *
+ * In contrast to 'select', 'poll', and 'kevent', which evaluate all watched
+ * file descriptors whenever their monitor function is executed,
+ * 'epoll_wait' evaluates only the items on the ready list of the epoll
+ * instance. An item enters the ready list when it is added or modified and
+ * whenever the VFS handle behind the file descriptor delivers a read-ready
+ * response. For the latter, each item installs itself as read-ready
+ * response handler at the VFS handle and forwards the responses to the
+ * handler installed before, i.e., the libc kernel.
+ *
+ * The VFS does not notify about write readiness. Hence, items waiting for
+ * EPOLLOUT remain on the ready list, as do items of file descriptors that
+ * are not backed by a VFS handle.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+#include <sys/epoll.h>
+#include <errno.h>
+
+/* internal includes */
+#include <internal/fd_alloc.h>
+#include <internal/file.h>
+#include <internal/init.h>
+#include <internal/monitor.h>
+#include <internal/epoll.h>
+#include <internal/errno.h>
+
+/* Genode includes */
+#include <base/id_space.h>
+#include <util/fifo.h>
+#include <vfs/vfs_handle.h>
+
+using namespace Libc;
+
+namespace Libc {
+	struct Epoll;
+
+	void notify_read_ready_from_kernel(File_descriptor *);
+
+	Vfs::Read_ready_response_handler *read_ready_handler_from_kernel(File_descriptor *);
+	void read_ready_handler_from_kernel(File_descriptor *, Vfs::Read_ready_response_handler *);
+}
+
+namespace { using Fn = Libc::Monitor::Function_result; }
+
+
+static Monitor            *_monitor_ptr;
+static Libc::Epoll_plugin *_epoll_plugin_ptr;
+
+
+static Libc::Monitor & monitor()
+{
+	struct Missing_call_of_init_epoll_support : Genode::Exception { };
+	if (!_monitor_ptr)
+		throw Missing_call_of_init_epoll_support();
+	return *_monitor_ptr;
+}
+
+
+/**
+ * Look up file descriptor that still refers to the file with 'context'
+ */
+static File_descriptor *lookup_fd(int libc_fd, Plugin_context const *context)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+
+	return (fd && fd->plugin && fd->context == context) ? fd : nullptr;
+}
+
+
+/*
+ * Epoll backend implementation
+ *
+ * All methods are executed in the context of the libc kernel, either as
+ * monitor functions or as read-ready response handlers.
+ */
+
+struct Libc::Epoll : Plugin_context
+{
+	struct Item;
+
+	using Items = Id_space<Item>;
+
+	/**
+	 * File descriptor registered at the epoll instance
+	 */
+	struct Item : Vfs::Read_ready_response_handler, Fifo<Item>::Element, Noncopyable
+	{
+		Epoll &_epoll;
+
+		Items::Element const _elem;
+
+		/* file referred to by the file descriptor on registration */
+		Plugin_context const * const context;
+
+		epoll_event event;
+
+		bool read_signalled = true;   /* read-ready response since last evaluation */
+		bool writable       = false;  /* write readiness on last evaluation */
+		bool disabled       = false;  /* EPOLLONESHOT item that fired */
+
+		/*
+		 * VFS file whose read-ready responses are observed, and the
+		 * previously installed handler of the VFS handle
+		 */
+		struct Hook
+		{
+			int                               libc_fd;
+			Plugin_context const             *context;
+			Vfs::Read_ready_response_handler *next_ptr;
+		} _hook { -1, nullptr, nullptr };
+
+		Item(Epoll &epoll, File_descriptor &fd, epoll_event const &event)
+		:
+			_epoll(epoll),
+			_elem(*this, epoll._items, Items::Id { (unsigned long)fd.libc_fd }),
+			context(fd.context), event(event)
+		{ }
+
+		~Item() { unhook(); }
+
+		File_descriptor *fd() const
+		{
+			return lookup_fd((int)_elem.id().value, context);
+		}
+
+		File_descriptor *hooked_file() const
+		{
+			return (_hook.libc_fd < 0) ? nullptr
+			                           : lookup_fd(_hook.libc_fd, _hook.context);
+		}
+
+		bool hooked() const { return hooked_file() != nullptr; }
+
+		/**
+		 * Install item as read-ready response handler of the VFS file
+		 * behind 'fd'
+		 *
+		 * The VFS file may change during the lifetime of the file
+		 * descriptor, e.g., when a socket starts listening.
+		 */
+		void hook(File_descriptor &fd)
+		{
+			File_descriptor * const file = fd.plugin->read_ready_file(&fd);
+
+			if (file && file == hooked_file())
+				return;
+
+			unhook();
+
+			if (!file)
+				return;
+
+			_hook = { file->libc_fd, file->context, read_ready_handler_from_kernel(file) };
+			read_ready_handler_from_kernel(file, this);
+		}
+
+		void unhook()
+		{
+			if (File_descriptor * const file = hooked_file()) {
+
+				Vfs::Read_ready_response_handler * const head =
+					read_ready_handler_from_kernel(file);
+
+				if (head == this) {
+					read_ready_handler_from_kernel(file, _hook.next_ptr);
+
+				} else {
+
+					/* remove item from the handler chain of other epoll instances */
+					for (Item *i = dynamic_cast<Item *>(head); i;
+					     i = dynamic_cast<Item *>(i->_hook.next_ptr)) {
+
+						if (i->_hook.next_ptr == this) {
+							i->_hook.next_ptr = _hook.next_ptr;
+							break;
+						}
+					}
+				}
+			}
+			_hook = { -1, nullptr, nullptr };
+		}
+
+		/**
+		 * Request read-ready response for the hooked VFS file
+		 */
+		void arm()
+		{
+			if (File_descriptor * const file = hooked_file())
+				notify_read_ready_from_kernel(file);
+		}
+
+		/**
+		 * Evaluate readiness of the file descriptor
+		 *
+		 * \return  events to report
+		 */
+		uint32_t evaluate(File_descriptor &fd)
+		{
+			hook(fd);
+
+			uint32_t const interest = event.events;
+
+			short revents = 0;
+			Plugin::Pollfd pollfd { .fdo = &fd, .events = 0, .revents = &revents };
+
+			if (interest & (EPOLLIN | EPOLLRDNORM))
+				pollfd.events |= POLLIN;
+			if (interest & (EPOLLOUT | EPOLLWRNORM))
+				pollfd.events |= POLLOUT;
+
+			/* arms the read-ready response if the file is not readable */
+			fd.plugin->poll(&pollfd, 1);
+
+			bool const edge_triggered  = interest & EPOLLET;
+			bool const readable        = revents & POLLIN;
+			bool const became_writable = (revents & POLLOUT) && !writable;
+
+			writable = revents & POLLOUT;
+
+			bool const report_in  = readable && (!edge_triggered || read_signalled);
+			bool const report_out = writable && (!edge_triggered || became_writable);
+
+			read_signalled = false;
+
+			return (report_in  ? interest & (EPOLLIN  | EPOLLRDNORM) : 0)
+			     | (report_out ? interest & (EPOLLOUT | EPOLLWRNORM) : 0);
+		}
+
+		/**
+		 * Vfs::Read_ready_response_handler interface
+		 */
+		void read_ready_response() override
+		{
+			read_signalled = true;
+			_epoll._enqueue(*this);
+
+			if (_hook.next_ptr)
+				_hook.next_ptr->read_ready_response();
+		}
+	};
+
+	Genode::Allocator &_alloc;
+
+	Items      _items { };
+	Fifo<Item> _ready { };
+
+	void _enqueue(Item &item)
+	{
+		if (!item.enqueued() && !item.disabled)
+			_ready.enqueue(item);
+	}
+
+	void _destroy(Item &item)
+	{
+		if (item.enqueued())
+			_ready.remove(item);
+
+		destroy(_alloc, &item);
+	}
+
+	Epoll(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+	~Epoll()
+	{
+		_ready.dequeue_all([] (Item &) { });
+
+		while (_items.apply_any<Item>([&] (Item &item) {
+			destroy(_alloc, &item); }));
+	}
+
+	/**
+	 * Apply control operation
+	 *
+	 * \return  0 on success, or errno value
+	 */
+	int ctl(int op, int libc_fd, epoll_event const *event)
+	{
+		File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+		if (!fd || !fd->plugin)
+			return EBADF;
+
+		if (fd->context == this)
+			return EINVAL;
+
+		if (!fd->plugin->supports_poll())
+			return EPERM;
+
+		if (op != EPOLL_CTL_DEL && !event)
+			return EFAULT;
+
+		Item *item_ptr = _items.apply<Item>(Items::Id { (unsigned long)libc_fd },
+			[&] (Item &item) { return &item; },
+			[&] () -> Item * { return nullptr; });
+
+		/* drop item of a file that was closed in the meantime */
+		if (item_ptr && item_ptr->context != fd->context) {
+			_destroy(*item_ptr);
+			item_ptr = nullptr;
+		}
+
+		switch (op) {
+
+		case EPOLL_CTL_ADD:
+
+			if (item_ptr)
+				return EEXIST;
+
+			_enqueue(*new (_alloc) Item(*this, *fd, *event));
+			return 0;
+
+		case EPOLL_CTL_MOD:
+
+			if (!item_ptr)
+				return ENOENT;
+
+			item_ptr->event          = *event;
+			item_ptr->read_signalled = true;
+			item_ptr->writable       = false;
+			item_ptr->disabled       = false;
+			_enqueue(*item_ptr);
+			return 0;
+
+		case EPOLL_CTL_DEL:
+
+			if (!item_ptr)
+				return ENOENT;
+
+			_destroy(*item_ptr);
+			return 0;
+		}
+
+		return EINVAL;
+	}
+
+	int wait(epoll_event *events, int maxevents, int timeout_ms)
+	{
+		int num_events = 0;
+
+		auto monitor_fn = [&] ()
+		{
+			/*
+			 * Evaluate the items that are on the ready list at this point.
+			 * Read-ready responses during the evaluation enqueue items
+			 * for the next round.
+			 */
+			Fifo<Item> pending { }, requeue { };
+
+			_ready.dequeue_all([&] (Item &item) { pending.enqueue(item); });
+
+			pending.dequeue_all([&] (Item &item) {
+
+				if (num_events == maxevents) {
+					requeue.enqueue(item);
+					return;
+				}
+
+				/*
+				 * Closing a file descriptor implicitly removes it from
+				 * the epoll instance.
+				 */
+				File_descriptor *fd = item.fd();
+				if (!fd) {
+					destroy(_alloc, &item);
+					return;
+				}
+
+				uint32_t const interest = item.event.events;
+				uint32_t const report   = item.evaluate(*fd);
+
+				if (report) {
+					events[num_events++] = { .events = report,
+					                         .data   = item.event.data };
+
+					if (interest & EPOLLONESHOT) {
+						item.disabled = true;
+						return;
+					}
+				}
+
+				/*
+				 * Level-triggered items remain ready until the condition
+				 * is consumed. Write readiness and files without VFS
+				 * handle must be polled.
+				 */
+				bool const keep = (report && !(interest & EPOLLET))
+				               || (interest & (EPOLLOUT | EPOLLWRNORM))
+				               || !item.hooked();
+				if (keep)
+					requeue.enqueue(item);
+				else
+					item.arm();
+			});
+
+			requeue.dequeue_all([&] (Item &item) { _enqueue(item); });
+
+			if (timeout_ms != 0 && num_events == 0)
+				return Fn::INCOMPLETE;
+
+			return Fn::COMPLETE;
+		};
+
+		/* a negative timeout blocks infinitely */
+		uint64_t const monitor_timeout_ms = (timeout_ms > 0) ? timeout_ms : 0;
+
+		Monitor::Result const monitor_result =
+			monitor().monitor(monitor_fn, monitor_timeout_ms);
+
+		if (monitor_result == Monitor::Result::TIMEOUT)
+			return 0;
+
+		return num_events;
+	}
+};
+
+
+void Libc::init_epoll(Genode::Allocator &alloc, Monitor &monitor,
+                      File_descriptor_allocator &fd_alloc)
+{
+	_epoll_plugin_ptr = new (alloc) Epoll_plugin(alloc);
+	_monitor_ptr      = &monitor;
+	_fd_alloc_ptr     = &fd_alloc;
+}
+
+
+static Epoll_plugin *epoll_plugin()
+{
+	if (!_epoll_plugin_ptr) {
+		error("libc epoll not initialized - aborting");
+		exit(1);
+	}
+
+	return _epoll_plugin_ptr;
+}
+
+
+int Libc::Epoll_plugin::create_epoll(int flags)
+{
+	Epoll *epoll = new (_alloc) Epoll(_alloc);
+
+	File_descriptor *fd =
+		file_descriptor_allocator()->alloc(this, epoll, Libc::ANY_FD);
+
+	if (!fd) {
+		destroy(_alloc, epoll);
+		return Errno(EMFILE);
+	}
+
+	fd->cloexec = (flags & EPOLL_CLOEXEC);
+
+	return fd->libc_fd;
+}
+
+
+int Libc::Epoll_plugin::close(File_descriptor *fd)
+{
+	if (fd->plugin != this)
+		return -1;
+
+	if (Epoll *epoll = static_cast<Epoll *>(fd->context))
+		monitor().monitor([&] {
+			destroy(_alloc, epoll);
+			return Fn::COMPLETE;
+		});
+
+	file_descriptor_allocator()->free(fd);
+
+	return 0;
+}
+
+
+static Epoll *epoll_by_libc_fd(int epfd)
+{
+	File_descriptor *fd = file_descriptor_allocator()->find_by_libc_fd(epfd);
+
+	if (!fd) {
+		errno = EBADF;
+		return nullptr;
+	}
+
+	if (fd->plugin != epoll_plugin() || !fd->context) {
+		errno = EINVAL;
+		return nullptr;
+	}
+
+	return static_cast<Epoll *>(fd->context);
+}
+
+
+extern "C" int epoll_create1(int flags)
+{
+	if (flags & ~EPOLL_CLOEXEC)
+		return Errno(EINVAL);
+
+	return epoll_plugin()->create_epoll(flags);
+}
+
+
+extern "C" int epoll_create(int size)
+{
+	if (size <= 0)
+		return Errno(EINVAL);
+
+	return epoll_create1(0);
+}
+
+
+extern "C" int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	Epoll *epoll = epoll_by_libc_fd(epfd);
+	if (!epoll)
+		return -1;
+
+	int err = 0;
+	monitor().monitor([&] {
+		err = epoll->ctl(op, fd, event);
+		return Fn::COMPLETE;
+	});
+
+	return err ? Errno(err) : 0;
+}
+
+
+extern "C" int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+                          int timeout)
+{
+	if (!events || maxevents <= 0)
+		return Errno(EINVAL);
+
+	Epoll *epoll = epoll_by_libc_fd(epfd);
+	if (!epoll)
+		return -1;
+
+	return epoll->wait(events, maxevents, timeout);
+}
@@ -332,6 +332,8 @@ struct Libc::Local_clone_service : Noncopyable
 {
 	struct Session : Session_object<Clone_session, Session>
 	{
+		Genode::Env::Local_rm &_rm;
+
 		Attached_ram_dataspace _ds;
 
 		static Session::Resources _resources()
@@ -344,6 +346,7 @@ struct Libc::Local_clone_service : Noncopyable
 		:
 			Session_object<Clone_session, Session>(ep.rpc_ep(), _resources(),
 			                                       "cloned", Session::Diag()),
+			_rm(env.rm()),
 			_ds(env.ram(), env.rm(), Clone_session::BUFFER_SIZE)
 		{ }
 
@@ -354,6 +357,23 @@ struct Libc::Local_clone_service : Noncopyable
 			::memcpy(_ds.local_addr<void>(), range.start, range.size);
 		}
 
+		bool dataspace_content(Dataspace_capability ds, Memory_range range)
+		{
+			try {
+				Attached_dataspace dst { _rm, ds };
+				if (dst.size() < range.size)
+					return false;
+
+				::memcpy(dst.local_addr<void>(), range.start, range.size);
+				return true;
+			}
+			catch (Attached_dataspace::Invalid_dataspace) { }
+			catch (Attached_dataspace::Region_conflict)   { }
+			catch (Out_of_ram)                            { }
+			catch (Out_of_caps)                           { }
+			return false;
+		}
+
 	} _session;
 
 	using Service = Local_service<Session>;
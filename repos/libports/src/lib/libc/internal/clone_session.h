@@ -45,8 +45,10 @@ struct Libc::Clone_session : Session
 
 	GENODE_RPC(Rpc_dataspace, Dataspace_capability, dataspace);
 	GENODE_RPC(Rpc_memory_content, void, memory_content, Memory_range);
+	GENODE_RPC(Rpc_dataspace_content, bool, dataspace_content,
+	           Dataspace_capability, Memory_range);
 
-	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_memory_content);
+	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_memory_content, Rpc_dataspace_content);
 };
 
 
@@ -85,6 +87,21 @@ struct Libc::Clone_connection : Connection<Clone_session>,
 		}
 	}
 
+	/**
+	 * Obtain memory content from cloned address space into dataspace
+	 *
+	 * In contrast to 'memory_content', the server writes the content
+	 * directly to the dataspace 'ds', which saves the copy via the
+	 * shared buffer and the round trip per buffer-sized chunk.
+	 *
+	 * \return false if the server could not fill the dataspace, e.g.,
+	 *         because it was unable to attach it
+	 */
+	bool dataspace_content(Dataspace_capability ds, void *src, size_t const len)
+	{
+		return call<Rpc_dataspace_content>(ds, Memory_range{ src, len });
+	}
+
 	template <typename OBJ>
 	void object_content(OBJ &obj) { memory_content(&obj, sizeof(obj)); }
 };
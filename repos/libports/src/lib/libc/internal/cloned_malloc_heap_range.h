@@ -63,7 +63,11 @@ struct Libc::Cloned_malloc_heap_range
 
 	void import_content(Clone_connection &clone_connection)
 	{
-		clone_connection.memory_content((void *)range.start, range.num_bytes);
+		void * const start = (void *)range.start;
+
+		/* fall back to the copy via the shared buffer */
+		if (!clone_connection.dataspace_content(ds, start, range.num_bytes))
+			clone_connection.memory_content(start, range.num_bytes);
 	}
 
 	virtual ~Cloned_malloc_heap_range()
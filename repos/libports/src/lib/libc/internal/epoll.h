@@ -0,0 +1,40 @@
+/*
+ * \brief  epoll plugin interface
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__INTERNAL__EPOLL_H_
+#define _LIBC__INTERNAL__EPOLL_H_
+
+/* Libc includes */
+#include <sys/epoll.h>
+
+#include <base/allocator.h>
+#include <internal/plugin.h>
+
+namespace Libc { class Epoll_plugin; }
+
+
+class Libc::Epoll_plugin : public Libc::Plugin
+{
+	private:
+
+		Genode::Allocator & _alloc;
+
+	public:
+
+		Epoll_plugin(Genode::Allocator & alloc) : _alloc(alloc) { }
+
+		int create_epoll(int flags);
+		int close(File_descriptor *) override;
+};
+
+#endif /* _LIBC__INTERNAL__EPOLL_H_ */
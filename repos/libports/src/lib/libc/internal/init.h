@@ -95,9 +95,11 @@ namespace Libc {
 	/**
 	 * Malloc allocator
 	 */
-	void init_malloc(Genode::Allocator &);
+	struct Malloc_thread_cache;
+	void init_malloc(Genode::Allocator &, Xml_node const &);
 	void init_malloc_cloned(Clone_connection &);
 	void reinit_malloc(Genode::Allocator &);
+	void release_malloc_thread_cache(Malloc_thread_cache *);
 
 	using Rtc_path = String<Vfs::MAX_PATH_LEN>;
 
@@ -157,6 +159,16 @@ namespace Libc {
 	 */
 	void init_kqueue(Genode::Allocator &, Monitor &, File_descriptor_allocator &);
 
+	/**
+	 * Epoll support
+	 */
+	void init_epoll(Genode::Allocator &, Monitor &, File_descriptor_allocator &);
+
+	/**
+	 * Asynchronous I/O support
+	 */
+	void init_aio(Genode::Allocator &, Monitor &, File_descriptor_allocator &);
+
 	/**
 	 * Random-number support
 	 */
@@ -123,6 +123,18 @@ namespace Libc {
 			virtual File_descriptor *open(const char *pathname, int flags);
 			virtual int pipe(File_descriptor *pipefd[2]);
 			virtual int poll(Pollfd fds[], int nfds);
+
+			/**
+			 * Return VFS-plugin file that delivers the read-ready responses
+			 * for 'fd', or nullptr if read readiness must be polled
+			 */
+			virtual File_descriptor *read_ready_file(File_descriptor *);
+
+			/**
+			 * Return VFS-plugin file that carries the data read from and
+			 * written to 'fd', or nullptr if there is no such file
+			 */
+			virtual File_descriptor *data_file(File_descriptor *);
 			virtual ssize_t read(File_descriptor *, void *buf, ::size_t count);
 			virtual ssize_t readlink(const char *path, char *buf, ::size_t bufsiz);
 			virtual ssize_t recv(File_descriptor *, void *buf, ::size_t len, int flags);
@@ -143,6 +155,20 @@ namespace Libc {
 			virtual File_descriptor *socket(int domain, int type, int protocol);
 			virtual int stat(const char *path, struct stat *buf);
 			virtual int symlink(const char *oldpath, const char *newpath);
+
+			/**
+			 * Transfer file content from 'in' to 'out' without copying it
+			 * to the caller
+			 *
+			 * Both files are provided by the plugin. The transfer starts at
+			 * 'offset' of 'in' and ends after 'count' bytes or at the end
+			 * of the file if 'count' is zero. The seek position of 'in'
+			 * is not changed.
+			 *
+			 * \return  number of bytes written to 'out'
+			 */
+			virtual ssize_t transfer(File_descriptor *in, ::off_t offset,
+			                         File_descriptor *out, ::size_t count);
 			virtual int unlink(const char *path);
 			virtual ssize_t write(File_descriptor *, const void *buf, ::size_t count);
 	};
@@ -38,6 +38,8 @@ namespace Libc {
 	struct Pthread_cleanup;
 	struct Pthread_job;
 	struct Pthread_mutex;
+
+	struct Malloc_thread_cache;
 }
 
 
@@ -186,6 +188,9 @@ struct Libc::Pthread : Noncopyable
 
 		int thread_local_errno = 0;
 
+		/* per-thread cache of the malloc implementation (if enabled) */
+		Malloc_thread_cache *malloc_cache = nullptr;
+
 		/**
 		 * Constructor for threads created via 'pthread_create'
 		 */
@@ -220,6 +225,8 @@ struct Libc::Pthread : Noncopyable
 		 */
 		Pthread(Thread &existing_thread, void *stack_address);
 
+		~Pthread();
+
 		static void init_tls_support();
 
 		void start() { _thread.start(); }
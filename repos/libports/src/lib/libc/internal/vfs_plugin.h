@@ -77,10 +77,20 @@ class Libc::Vfs_plugin final : public Plugin
 			void            * const start;
 			Vfs::Vfs_handle * const reference_handle;
 
+			/* file dataspace of a read-only private mapping */
+			Genode::Dataspace_capability const file_ds { };
+			Absolute_path                const path    { };
+
 			Mmap_entry(Registry<Mmap_entry> &registry, void *start,
 			           Vfs::Vfs_handle *reference_handle)
 			: Registry<Mmap_entry>::Element(registry, *this), start(start),
 			  reference_handle(reference_handle) { }
+
+			Mmap_entry(Registry<Mmap_entry> &registry, void *start,
+			           Vfs::Vfs_handle *reference_handle,
+			           Genode::Dataspace_capability file_ds, Absolute_path const &path)
+			: Registry<Mmap_entry>::Element(registry, *this), start(start),
+			  reference_handle(reference_handle), file_ds(file_ds), path(path) { }
 		};
 
 		File_descriptor_allocator        &_fd_alloc;
@@ -120,6 +130,14 @@ class Libc::Vfs_plugin final : public Plugin
 
 		} _cached_ioctl_info { *this };
 
+		/**
+		 * Map file dataspace read-only, return nullptr if unavailable
+		 *
+		 * The dataspace is used only if obtaining it is not more expensive
+		 * than copying 'length' bytes of the file.
+		 */
+		void *_mmap_file_dataspace(::size_t, File_descriptor &, ::off_t);
+
 		/**
 		 * Sync a handle
 		 */
@@ -224,12 +242,15 @@ class Libc::Vfs_plugin final : public Plugin
 		File_descriptor *open(const char *path, int flags) override;
 		int     pipe(File_descriptor *pipefdo[2]) override;
 		int     poll(Pollfd fds[], int nfds) override;
+		File_descriptor *read_ready_file(File_descriptor *fd) override { return fd; }
+		File_descriptor *data_file(File_descriptor *fd) override { return fd; }
 		ssize_t read(File_descriptor *, void *, ::size_t) override;
 		ssize_t readlink(const char *, char *, ::size_t) override;
 		int     rename(const char *, const char *) override;
 		int     rmdir(const char *) override;
 		int     stat(const char *, struct stat *) override;
 		int     symlink(const char *, const char *) override;
+		ssize_t transfer(File_descriptor *, ::off_t, File_descriptor *, ::size_t) override;
 		int     unlink(const char *) override;
 		ssize_t write(File_descriptor *, const void *, ::size_t ) override;
 		void   *mmap(void *, ::size_t, int, int, File_descriptor *, ::off_t) override;
@@ -497,7 +497,8 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 
 	} else {
 		_malloc_heap.construct(*_malloc_ram, _env.rm());
-		init_malloc(*_malloc_heap);
+		_with_libc_sub_config("malloc", [&] (Xml_node const &malloc_config) {
+			init_malloc(*_malloc_heap, malloc_config); });
 	}
 
 	init_fork(_env, _fd_alloc, _libc_env, _heap, *_malloc_heap, _config.pid, *this,
@@ -520,6 +521,8 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 
 	init_signal(_signal);
 	init_kqueue(_heap, *this, _fd_alloc);
+	init_epoll(_heap, *this, _fd_alloc);
+	init_aio(_heap, *this, _fd_alloc);
 	init_random(_config);
 
 	_init_file_descriptors();
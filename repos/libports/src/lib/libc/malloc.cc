@@ -30,6 +30,7 @@ extern "C" {
 #include <internal/init.h>
 #include <internal/clone_session.h>
 #include <internal/errno.h>
+#include <internal/pthread.h>
 
 
 namespace Libc {
@@ -52,7 +53,7 @@ class Libc::Slab_alloc : public Slab
 
 	public:
 
-		Slab_alloc(size_t object_size, Allocator &backing_store)
+		Slab_alloc(size_t object_size, Genode::Allocator &backing_store)
 		:
 			Slab(object_size, _calculate_block_size(object_size), 0, &backing_store),
 			_object_size(object_size)
@@ -69,6 +70,49 @@ class Libc::Slab_alloc : public Slab
 };
 
 
+/**
+ * Per-thread cache of free slab entries
+ *
+ * The cache keeps a bounded number of free entries per size class. Entries
+ * are obtained from and returned to the shared slabs in batches so that the
+ * malloc mutex is taken only once per batch. Entries freed by another thread
+ * than the allocating one simply enter the cache of the freeing thread and
+ * flow back to the shared slabs once the cache overflows.
+ */
+struct Libc::Malloc_thread_cache
+{
+	enum { MAX_BINS = 10 };
+
+	struct Entry { Entry *next; };
+
+	struct Bin
+	{
+		Entry    *head  = nullptr;
+		unsigned  count = 0;
+
+		void push(void *ptr)
+		{
+			Entry *entry = (Entry *)ptr;
+			entry->next = head;
+			head = entry;
+			count++;
+		}
+
+		void *pop()
+		{
+			Entry *entry = head;
+			if (entry) {
+				head = entry->next;
+				count--;
+			}
+			return entry;
+		}
+	};
+
+	Bin bins[MAX_BINS] { };
+};
+
+
 /**
  * Allocator that uses slabs for small objects sizes
  */
@@ -82,10 +126,20 @@ class Libc::Malloc
 		enum {
 			SLAB_START    = 5,  /* 32 bytes (log2) */
 			SLAB_STOP     = 11, /* 2048 bytes (log2) */
-			NUM_SLABS     = (SLAB_STOP - SLAB_START) + 1,
-			DEFAULT_ALIGN = 16
+			SLAB_STOP_TC  = 14, /* 16 KiB (log2) with thread caching */
+			NUM_SLABS     = (SLAB_STOP_TC - SLAB_START) + 1,
+			DEFAULT_ALIGN = 16,
+
+			/* amount of memory per size class cached by a thread */
+			CACHE_BYTES_PER_BIN = 32*1024,
+			MIN_CACHE_ENTRIES   = 4,
+			MAX_CACHE_ENTRIES   = 128,
 		};
 
+		static_assert(NUM_SLABS <= Malloc_thread_cache::MAX_BINS);
+
+		using Bin = Malloc_thread_cache::Bin;
+
 		struct Metadata
 		{
 			size_t size;
@@ -119,7 +173,12 @@ class Libc::Malloc
 			return sizeof(Metadata) + (align - 1);
 		}
 
-		Allocator &_backing_store; /* back-end allocator */
+		Genode::Allocator &_backing_store; /* back-end allocator */
+
+		bool const _thread_caching;
+
+		/* largest slab size (log2), larger allocations use the backing store */
+		unsigned const _slab_stop = _thread_caching ? SLAB_STOP_TC : SLAB_STOP;
 
 		Constructible<Slab_alloc> _slabs[NUM_SLABS]; /* slab allocators */
 
@@ -140,37 +199,133 @@ class Libc::Malloc
 			return msb;
 		}
 
+		static unsigned _cache_capacity(unsigned msb)
+		{
+			return Genode::min((unsigned)MAX_CACHE_ENTRIES,
+			                   Genode::max((unsigned)MIN_CACHE_ENTRIES,
+			                               (unsigned)(CACHE_BYTES_PER_BIN >> msb)));
+		}
+
+		/**
+		 * Return cache of the calling thread, or nullptr if not available
+		 *
+		 * Threads not created via pthread (and the main thread before its
+		 * first 'pthread_self()' call) use the shared slabs only.
+		 */
+		Malloc_thread_cache *_thread_cache()
+		{
+			if (!_thread_caching)
+				return nullptr;
+
+			Pthread * const myself = Pthread::myself();
+			if (!myself)
+				return nullptr;
+
+			if (!myself->malloc_cache) {
+				Mutex::Guard guard(_mutex);
+				_backing_store.try_alloc(sizeof(Malloc_thread_cache)).with_result(
+					[&] (Range_allocator::Allocation &a) {
+						a.deallocate = false;
+						myself->malloc_cache = construct_at<Malloc_thread_cache>(a.ptr); },
+					[&] (Alloc_error) { });
+			}
+			return myself->malloc_cache;
+		}
+
+		void *_slab_alloc(unsigned msb)
+		{
+			Slab_alloc &slab = *_slabs[msb - SLAB_START];
+
+			Malloc_thread_cache * const cache = _thread_cache();
+			if (!cache) {
+				Mutex::Guard guard(_mutex);
+				return slab.alloc();
+			}
+
+			Bin &bin = cache->bins[msb - SLAB_START];
+			if (!bin.head) {
+				Mutex::Guard guard(_mutex);
+				for (unsigned i = 0; i < _cache_capacity(msb)/2; i++) {
+					void * const ptr = slab.alloc();
+					if (!ptr)
+						break;
+					bin.push(ptr);
+				}
+			}
+			return bin.pop();
+		}
+
+		void _slab_free(unsigned msb, void *ptr)
+		{
+			Slab_alloc &slab = *_slabs[msb - SLAB_START];
+
+			Malloc_thread_cache * const cache = _thread_cache();
+			if (!cache) {
+				Mutex::Guard guard(_mutex);
+				slab.dealloc(ptr);
+				return;
+			}
+
+			Bin &bin = cache->bins[msb - SLAB_START];
+			bin.push(ptr);
+
+			if (bin.count > _cache_capacity(msb)) {
+				Mutex::Guard guard(_mutex);
+				for (unsigned i = 0; i < _cache_capacity(msb)/2; i++)
+					slab.dealloc(bin.pop());
+			}
+		}
+
 	public:
 
-		Malloc(Allocator &backing_store) : _backing_store(backing_store)
+		Malloc(Genode::Allocator &backing_store, bool thread_caching)
+		:
+			_backing_store(backing_store), _thread_caching(thread_caching)
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
+			for (unsigned i = SLAB_START; i <= _slab_stop; i++)
 				_slabs[i - SLAB_START].construct(1U << i, backing_store);
 		}
 
 		~Malloc() { warning(__func__, " unexpectedly called"); }
 
+		bool thread_caching() const { return _thread_caching; }
+
+		/**
+		 * Return cached entries of a terminated thread to the slabs
+		 */
+		void release(Malloc_thread_cache &cache)
+		{
+			Mutex::Guard guard(_mutex);
+
+			for (unsigned i = SLAB_START; i <= _slab_stop; i++) {
+				Bin &bin = cache.bins[i - SLAB_START];
+				while (bin.head)
+					_slabs[i - SLAB_START]->dealloc(bin.pop());
+			}
+			_backing_store.free(&cache, sizeof(cache));
+		}
+
 		/**
 		 * Allocator interface
 		 */
 
 		void * alloc(size_t size, size_t align = DEFAULT_ALIGN)
 		{
-			Mutex::Guard guard(_mutex);
-
 			size_t   const real_size = size + _room(align);
 			unsigned const msb       = _slab_log2(real_size);
 
 			void *alloc_addr = nullptr;
 
 			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP)
+			if (msb > _slab_stop) {
+				Mutex::Guard guard(_mutex);
 				_backing_store.try_alloc(real_size).with_result(
 					[&] (Range_allocator::Allocation &a) {
 						a.deallocate = false; alloc_addr = a.ptr; },
 					[&] (Alloc_error) { });
+			}
 			else
-				alloc_addr = _slabs[msb - SLAB_START]->alloc();
+				alloc_addr = _slab_alloc(msb);
 
 			if (!alloc_addr) return nullptr;
 
@@ -210,8 +365,6 @@ class Libc::Malloc
 
 		void free(void *ptr)
 		{
-			Mutex::Guard lock_guard(_mutex);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
 			size_t   const  real_size  = md->size;
@@ -223,10 +376,11 @@ class Libc::Malloc
 				error("libc free: meta-data offset is 0 for address: ", ptr,
 				      " - corrupted allocation");
 
-			if (msb > SLAB_STOP) {
+			if (msb > _slab_stop) {
+				Mutex::Guard guard(_mutex);
 				_backing_store.free(alloc_addr, real_size);
 			} else {
-				_slabs[msb - SLAB_START]->dealloc(alloc_addr);
+				_slab_free(msb, alloc_addr);
 			}
 		}
 };
@@ -287,9 +441,10 @@ int posix_memalign(void **memptr, size_t alignment, size_t size)
 static long _malloc_obj[(sizeof(Malloc) + sizeof(long))/sizeof(long)];
 
 
-void Libc::init_malloc(Genode::Allocator &heap)
+void Libc::init_malloc(Genode::Allocator &heap, Xml_node const &config)
 {
-	mallocator = construct_at<Malloc>(_malloc_obj, heap);
+	mallocator = construct_at<Malloc>(_malloc_obj, heap,
+	                                  config.attribute_value("thread_cache", false));
 }
 
 
@@ -302,5 +457,18 @@ void Libc::init_malloc_cloned(Clone_connection &clone_connection)
 
 void Libc::reinit_malloc(Genode::Allocator &heap)
 {
-	construct_at<Libc::Malloc>(_malloc_obj, heap);
+	bool const thread_caching = mallocator->thread_caching();
+
+	/* the cache of the calling thread refers to the previous heap */
+	if (Pthread *myself = Pthread::myself())
+		myself->malloc_cache = nullptr;
+
+	construct_at<Libc::Malloc>(_malloc_obj, heap, thread_caching);
+}
+
+
+void Libc::release_malloc_thread_cache(Malloc_thread_cache *cache)
+{
+	if (cache)
+		mallocator->release(*cache);
 }
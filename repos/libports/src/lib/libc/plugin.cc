@@ -157,6 +157,8 @@ DUMMY(File_descriptor *, 0, dup,    (File_descriptor *));
 DUMMY(File_descriptor *, 0, open,   (const char *, int));
 DUMMY(File_descriptor *, 0, socket, (int, int, int));
 DUMMY(File_descriptor *, 0, accept, (File_descriptor *, struct sockaddr *, socklen_t *));
+DUMMY(File_descriptor *, 0, read_ready_file, (File_descriptor *));
+DUMMY(File_descriptor *, 0, data_file,       (File_descriptor *));
 
 
 /*
@@ -186,6 +188,7 @@ DUMMY(ssize_t, -1, send,          (File_descriptor *, const void *, ::size_t, in
 DUMMY(ssize_t, -1, sendto,        (File_descriptor *, const void *, ::size_t, int, const struct sockaddr *, socklen_t));
 DUMMY(int,     -1, setsockopt,    (File_descriptor *, int, int, const void *, socklen_t));
 DUMMY(int,     -1, shutdown,      (File_descriptor *, int));
+DUMMY(ssize_t, -1, transfer,      (File_descriptor *, ::off_t, File_descriptor *, ::size_t));
 DUMMY(ssize_t, -1, write,         (File_descriptor *, const void *, ::size_t));
 
 
@@ -1,5 +1,5 @@
 /*
- * \brief  'pread()' and 'pwrite()' implementations
+ * \brief  'pread()', 'pwrite()', 'preadv()', and 'pwritev()' implementations
  * \author Christian Prochaska
  * \date   2012-07-11
  */
@@ -43,6 +43,24 @@ struct Write
 };
 
 
+struct Readv
+{
+	ssize_t operator()(int fd, const struct iovec *iov, size_t iovcnt)
+	{
+		return readv(fd, iov, (int)iovcnt);
+	}
+};
+
+
+struct Writev
+{
+	ssize_t operator()(int fd, const struct iovec *iov, size_t iovcnt)
+	{
+		return writev(fd, iov, (int)iovcnt);
+	}
+};
+
+
 static Libc::File_descriptor_allocator *_fd_alloc_ptr;
 
 
@@ -102,3 +120,21 @@ extern "C" ssize_t pwrite(int fd, const void *buf, ::size_t count, ::off_t offse
 
 extern "C" __attribute__((alias("pwrite")))
 ssize_t __sys_pwrite(int fd, const void *buf, ::size_t count, ::off_t offset);
+
+
+extern "C" ssize_t preadv(int fd, const struct iovec *iov, int iovcnt, ::off_t offset)
+{
+	return pread_pwrite_impl(Readv(), fd, iov, iovcnt, offset);
+}
+
+extern "C" __attribute__((alias("preadv")))
+ssize_t __sys_preadv(int fd, const struct iovec *iov, int iovcnt, ::off_t offset);
+
+
+extern "C" ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt, ::off_t offset)
+{
+	return pread_pwrite_impl(Writev(), fd, iov, iovcnt, offset);
+}
+
+extern "C" __attribute__((alias("pwritev")))
+ssize_t __sys_pwritev(int fd, const struct iovec *iov, int iovcnt, ::off_t offset);
@@ -15,6 +15,7 @@
 /* Genode includes */
 #include <base/log.h>
 #include <base/thread.h>
+#include <cpu/atomic.h>
 #include <util/list.h>
 #include <libc/allocator.h>
 
@@ -119,6 +120,16 @@ Libc::Pthread::Pthread(Thread &existing_thread, void *stack_address)
 }
 
 
+Libc::Pthread::~Pthread()
+{
+	/*
+	 * The thread is blocked or sleeping forever at this point, so its cache
+	 * can be returned safely from the destructing thread.
+	 */
+	release_malloc_thread_cache(malloc_cache);
+}
+
+
 void Libc::Pthread::init_tls_support()
 {
 	Thread::Stack_info info = Thread::mystack();
@@ -234,10 +245,21 @@ class pthread_mutex : Genode::Noncopyable
 
 		Applicant *_applicants { nullptr };
 
-	protected:
+		/*
+		 * Lock word of the fast path
+		 *
+		 * Without contention, the mutex is acquired and released by a
+		 * single compare-and-exchange of the lock word. A contender that
+		 * blocks marks the lock word as CONTENDED while holding
+		 * '_data_mutex', which directs the next release to the slow path
+		 * that hands the mutex over to the first applicant.
+		 */
+		enum { UNLOCKED = 0, LOCKED = 1, CONTENDED = 2 };
+
+		int volatile _state { UNLOCKED };
 
-		pthread_t _owner      { nullptr };
-		Mutex     _data_mutex;
+		/* number of attempts to acquire the mutex before blocking */
+		enum { SPIN_ATTEMPTS = 100 };
 
 		/* _data_mutex must be hold when calling the following methods */
 
@@ -264,9 +286,12 @@ class pthread_mutex : Genode::Noncopyable
 			if (Applicant *next = _applicants) {
 				_remove_applicant(next);
 				_owner = next->thread;
+				if (!_applicants)
+					_state = LOCKED;
 				next->blockade.wakeup();
 			} else {
 				_owner = nullptr;
+				Genode::cmpxchg(&_state, CONTENDED, UNLOCKED);
 			}
 		}
 
@@ -315,6 +340,75 @@ class pthread_mutex : Genode::Noncopyable
 			}
 		}
 
+		/**
+		 * Mark the mutex as contended unless it got released meanwhile
+		 *
+		 * Return true if the mutex was acquired.
+		 */
+		bool _acquire_or_mark_contended()
+		{
+			for (;;) {
+				int const state = _state;
+
+				if (state == UNLOCKED && Genode::cmpxchg(&_state, UNLOCKED, CONTENDED))
+					return true;
+
+				if (state == CONTENDED || (state == LOCKED &&
+				    Genode::cmpxchg(&_state, LOCKED, CONTENDED)))
+					return false;
+			}
+		}
+
+	protected:
+
+		pthread_t volatile _owner { nullptr };
+		Mutex              _data_mutex;
+
+		/**
+		 * Acquire mutex without contention
+		 */
+		bool _try_acquire(pthread_t thread)
+		{
+			if (!Genode::cmpxchg(&_state, UNLOCKED, LOCKED))
+				return false;
+
+			_owner = thread;
+			return true;
+		}
+
+		/**
+		 * Acquire mutex by spinning briefly and blocking afterwards
+		 *
+		 * Return true if mutex was acquired, false on timeout expiration.
+		 */
+		bool _acquire(pthread_t thread, Libc::uint64_t timeout_ms)
+		{
+			for (unsigned i = 0; i < SPIN_ATTEMPTS; i++)
+				if (_state == UNLOCKED && _try_acquire(thread))
+					return true;
+
+			Mutex::Guard guard(_data_mutex);
+
+			if (_acquire_or_mark_contended()) {
+				_owner = thread;
+				return true;
+			}
+
+			return _apply_for_mutex(thread, timeout_ms);
+		}
+
+		void _release()
+		{
+			_owner = nullptr;
+
+			if (Genode::cmpxchg(&_state, LOCKED, UNLOCKED))
+				return;
+
+			Mutex::Guard guard(_data_mutex);
+
+			_next_applicant_to_owner();
+		}
+
 	public:
 
 		pthread_mutex() { }
@@ -335,28 +429,15 @@ class pthread_mutex : Genode::Noncopyable
 
 struct Libc::Pthread_mutex_normal : pthread_mutex
 {
-	/* unsynchronized try */
-	int _try_lock(pthread_t thread)
-	{
-		if (!_owner) {
-			_owner = thread;
-			return 0;
-		}
-
-		return EBUSY;
-	}
-
 	int lock() override final
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
-
 		/* fast path without lock contention */
-		if (_try_lock(myself) == 0)
+		if (_try_acquire(myself))
 			return 0;
 
-		_apply_for_mutex(myself, 0);
+		_acquire(myself, 0);
 
 		return 0;
 	}
@@ -365,10 +446,8 @@ struct Libc::Pthread_mutex_normal : pthread_mutex
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
-
 		/* fast path without lock contention - does not check abstimeout according to spec */
-		if (_try_lock(myself) == 0)
+		if (_try_acquire(myself))
 			return 0;
 
 		timespec abs_now;
@@ -378,7 +457,7 @@ struct Libc::Pthread_mutex_normal : pthread_mutex
 		if (!timeout_ms)
 			return ETIMEDOUT;
 
-		if (_apply_for_mutex(myself, timeout_ms))
+		if (_acquire(myself, timeout_ms))
 			return 0;
 		else
 			return ETIMEDOUT;
@@ -386,21 +465,15 @@ struct Libc::Pthread_mutex_normal : pthread_mutex
 
 	int trylock() override final
 	{
-		pthread_t const myself = pthread_self();
-
-		Mutex::Guard guard(_data_mutex);
-
-		return _try_lock(myself);
+		return _try_acquire(pthread_self()) ? 0 : EBUSY;
 	}
 
 	int unlock() override final
 	{
-		Mutex::Guard guard(_data_mutex);
-
 		if (_owner != pthread_self())
 			return EPERM;
 
-		_next_applicant_to_owner();
+		_release();
 
 		return 0;
 	}
@@ -409,29 +482,18 @@ struct Libc::Pthread_mutex_normal : pthread_mutex
 
 struct Libc::Pthread_mutex_errorcheck : pthread_mutex
 {
-	/* unsynchronized try */
-	int _try_lock(pthread_t thread)
-	{
-		if (!_owner) {
-			_owner = thread;
-			return 0;
-		}
-
-		return _owner == thread ? EDEADLK : EBUSY;
-	}
-
 	int lock() override final
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
+		/* fast path without lock contention */
+		if (_try_acquire(myself))
+			return 0;
 
-		/* fast path without lock contention (or deadlock) */
-		int const result = _try_lock(myself);
-		if (!result || result == EDEADLK)
-			return result;
+		if (_owner == myself)
+			return EDEADLK;
 
-		_apply_for_mutex(myself, 0);
+		_acquire(myself, 0);
 
 		return 0;
 	}
@@ -446,19 +508,18 @@ struct Libc::Pthread_mutex_errorcheck : pthread_mutex
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
+		if (_try_acquire(myself))
+			return 0;
 
-		return _try_lock(myself);
+		return _owner == myself ? EDEADLK : EBUSY;
 	}
 
 	int unlock() override final
 	{
-		Mutex::Guard guard(_data_mutex);
-
 		if (_owner != pthread_self())
 			return EPERM;
 
-		_next_applicant_to_owner();
+		_release();
 
 		return 0;
 	}
@@ -467,33 +528,23 @@ struct Libc::Pthread_mutex_errorcheck : pthread_mutex
 
 struct Libc::Pthread_mutex_recursive : pthread_mutex
 {
+	/* accessed by the owner only */
 	unsigned _nesting_level { 0 };
 
-	/* unsynchronized try */
-	int _try_lock(pthread_t thread)
-	{
-		if (!_owner) {
-			_owner = thread;
-			return 0;
-		} else if (_owner == thread) {
-			++_nesting_level;
-			return 0;
-		}
-
-		return EBUSY;
-	}
-
 	int lock() override final
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
+		if (_owner == myself) {
+			++_nesting_level;
+			return 0;
+		}
 
 		/* fast path without lock contention */
-		if (_try_lock(myself) == 0)
+		if (_try_acquire(myself))
 			return 0;
 
-		_apply_for_mutex(myself, 0);
+		_acquire(myself, 0);
 
 		return 0;
 	}
@@ -507,20 +558,21 @@ struct Libc::Pthread_mutex_recursive : pthread_mutex
 	{
 		pthread_t const myself = pthread_self();
 
-		Mutex::Guard guard(_data_mutex);
+		if (_owner == myself) {
+			++_nesting_level;
+			return 0;
+		}
 
-		return _try_lock(myself);
+		return _try_acquire(myself) ? 0 : EBUSY;
 	}
 
 	int unlock() override final
 	{
-		Mutex::Guard guard(_data_mutex);
-
 		if (_owner != pthread_self())
 			return EPERM;
 
 		if (_nesting_level == 0)
-			_next_applicant_to_owner();
+			_release();
 		else
 			--_nesting_level;
 
@@ -13,7 +13,7 @@
  */
 
 /* Genode includes */
-#include <base/mutex.h>
+#include <util/misc_math.h>
 
 /* libc includes */
 #include <sys/uio.h>
@@ -21,6 +21,7 @@
 #include <unistd.h>
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 /* libc-internal includes */
 #include <internal/types.h>
@@ -28,95 +29,169 @@
 using namespace Libc;
 
 
-struct Read
-{
-	ssize_t operator()(int fd, void *buf, size_t count)
-	{
-		return read(fd, buf, count);
-	}
-};
+enum { GATHER_SIZE = 4096 };
 
 
-struct Write
+/**
+ * Return total length of I/O vector, or -1 if invalid
+ */
+static ssize_t total_length(const struct iovec *iov, int iovcnt)
 {
-	ssize_t operator()(int fd, const void *buf, size_t count)
-	{
-		return write(fd, buf, count);
+	if (iovcnt < 1 || iovcnt > IOV_MAX)
+		return -1;
+
+	size_t total = 0;
+	for (int i = 0; i < iovcnt; i++) {
+		if (iov[i].iov_len > SSIZE_MAX - total)
+			return -1;
+		total += iov[i].iov_len;
 	}
-};
+	return (ssize_t)total;
+}
 
 
-template <typename Rw_func>
-static ssize_t readv_writev_impl(Rw_func rw_func, int fd, const struct iovec *iov, int iovcnt)
+static ssize_t write_all(int fd, char const *buf, size_t count)
 {
-	/* FIXME this should be a pthread_mutex because function uses blocking operations */
-	static Mutex rw_mutex;
+	size_t written = 0;
 
-	Mutex::Guard guard(rw_mutex);
+	while (written < count) {
+		ssize_t const n = write(fd, buf + written, count - written);
 
-	char *v;
-	ssize_t bytes_transfered_total = 0;
-	size_t v_len = 0;
-	int i;
+		if (n == -1)
+			return written ? (ssize_t)written : -1;
 
-	if (iovcnt < 1 || iovcnt > IOV_MAX) {
-		errno = EINVAL;
-		return -1;
+		if (n == 0)
+			break;
+
+		written += n;
 	}
+	return (ssize_t)written;
+}
 
-	for (i = 0; i < iovcnt; i++)
-		v_len += iov->iov_len;
 
-	if (v_len > SSIZE_MAX) {
+/*
+ * Small vector elements are gathered into a local buffer so that a vector of
+ * many small elements results in a single VFS write operation. Elements
+ * that do not fit into the buffer are written directly.
+ */
+extern "C" ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
+{
+	if (total_length(iov, iovcnt) < 0) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	while (iovcnt > 0) {
-		v = static_cast<char *>(iov->iov_base);
-		v_len = iov->iov_len;
+	char   gather[GATHER_SIZE];
+	size_t gathered = 0;
+	size_t total    = 0;
 
-		while (v_len > 0) {
-			ssize_t bytes_transfered = rw_func(fd, v, v_len);
+	/* write gathered data, return false on short write */
+	auto flush = [&] () -> bool
+	{
+		if (!gathered)
+			return true;
+
+		ssize_t const n = write_all(fd, gather, gathered);
+
+		bool const complete = (n == (ssize_t)gathered);
+		if (n > 0)
+			total += n;
+
+		gathered = 0;
+		return complete;
+	};
 
-			if (bytes_transfered == -1)
-				return -1;
+	for (int i = 0; i < iovcnt; i++) {
 
-			if (bytes_transfered == 0)
-				return bytes_transfered_total;
+		char const * const src = (char const *)iov[i].iov_base;
+		size_t       const len = iov[i].iov_len;
 
-			v_len -= bytes_transfered;
-			v += bytes_transfered;
-			bytes_transfered_total += bytes_transfered;
+		if (len <= GATHER_SIZE - gathered) {
+			::memcpy(gather + gathered, src, len);
+			gathered += len;
+			continue;
 		}
 
-		iov++;
-		iovcnt--;
+		if (!flush())
+			return total ? (ssize_t)total : -1;
+
+		if (len <= GATHER_SIZE) {
+			::memcpy(gather, src, len);
+			gathered = len;
+			continue;
+		}
+
+		ssize_t const n = write_all(fd, src, len);
+		if (n > 0)
+			total += n;
+
+		if (n != (ssize_t)len)
+			return total ? (ssize_t)total : -1;
 	}
 
-	return bytes_transfered_total;
+	if (!flush() && !total)
+		return -1;
+
+	return (ssize_t)total;
 }
 
+extern "C" __attribute__((alias("writev")))
+ssize_t __sys_writev(int fd, const struct iovec *iov, int iovcnt);
+
+extern "C" __attribute__((alias("writev")))
+ssize_t _writev(int fd, const struct iovec *iov, int iovcnt);
 
+
+/*
+ * A vector that fits into the local buffer is read by a single VFS read
+ * operation and scattered afterwards. Larger vectors are read element-wise
+ * until a read returns less than requested, which indicates the end of the
+ * file or the end of the data available at a socket or pipe.
+ */
 extern "C" ssize_t readv(int fd, const struct iovec *iov, int iovcnt)
 {
-	return readv_writev_impl(Read(), fd, iov, iovcnt);
-}
+	ssize_t const length = total_length(iov, iovcnt);
+	if (length < 0) {
+		errno = EINVAL;
+		return -1;
+	}
 
-extern "C" __attribute__((alias("readv")))
-ssize_t __sys_readv(int fd, const struct iovec *iov, int iovcnt);
+	if (length <= GATHER_SIZE) {
 
-extern "C" __attribute__((alias("readv")))
-ssize_t _readv(int fd, const struct iovec *iov, int iovcnt);
+		char scatter[GATHER_SIZE];
 
+		ssize_t const n = read(fd, scatter, length);
+		if (n <= 0)
+			return n;
 
-extern "C" ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
-{
-	return readv_writev_impl(Write(), fd, iov, iovcnt);
+		size_t offset = 0;
+		for (int i = 0; i < iovcnt && offset < (size_t)n; i++) {
+			size_t const len = Genode::min(iov[i].iov_len, (size_t)n - offset);
+			::memcpy(iov[i].iov_base, scatter + offset, len);
+			offset += len;
+		}
+		return n;
+	}
+
+	size_t total = 0;
+
+	for (int i = 0; i < iovcnt; i++) {
+
+		ssize_t const n = read(fd, iov[i].iov_base, iov[i].iov_len);
+
+		if (n == -1)
+			return total ? (ssize_t)total : -1;
+
+		total += n;
+
+		if ((size_t)n < iov[i].iov_len)
+			break;
+	}
+	return (ssize_t)total;
 }
 
-extern "C" __attribute__((alias("writev")))
-ssize_t __sys_writev(int fd, const struct iovec *iov, int iovcnt);
+extern "C" __attribute__((alias("readv")))
+ssize_t __sys_readv(int fd, const struct iovec *iov, int iovcnt);
 
-extern "C" __attribute__((alias("writev")))
-ssize_t _writev(int fd, const struct iovec *iov, int iovcnt);
+extern "C" __attribute__((alias("readv")))
+ssize_t _readv(int fd, const struct iovec *iov, int iovcnt);
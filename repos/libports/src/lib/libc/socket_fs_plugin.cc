@@ -292,6 +292,18 @@ struct Libc::Socket_fs::Context : Plugin_context
 			return (_state == ACCEPT_ONLY) ? accept_read_ready() : data_read_ready();
 		}
 
+		/* VFS file evaluated by 'read_ready' */
+		File_descriptor *read_ready_file()
+		{
+			return (_state == ACCEPT_ONLY) ? _fd[Fd::ACCEPT].file : _fd[Fd::DATA].file;
+		}
+
+		/* VFS file carrying the payload of a connected socket */
+		File_descriptor *data_file()
+		{
+			return (_state == CONNECTED) ? _fd[Fd::DATA].file : nullptr;
+		}
+
 		bool write_ready()
 		{
 			if (_state == CONNECTING)
@@ -383,6 +395,8 @@ struct Libc::Socket_fs::Plugin : Libc::Plugin
 	int fcntl(File_descriptor *, int, long) override;
 	int close(File_descriptor *) override;
 	int poll(Pollfd fds[], int nfds) override;
+	File_descriptor *read_ready_file(File_descriptor *) override;
+	File_descriptor *data_file(File_descriptor *) override;
 	int ioctl(File_descriptor *, unsigned long, char *) override;
 };
 
@@ -1387,6 +1401,22 @@ int Socket_fs::Plugin::poll(Pollfd fds[], int nfds)
 }
 
 
+File_descriptor *Socket_fs::Plugin::read_ready_file(File_descriptor *fd)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+
+	return context ? context->read_ready_file() : nullptr;
+}
+
+
+File_descriptor *Socket_fs::Plugin::data_file(File_descriptor *fd)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+
+	return context ? context->data_file() : nullptr;
+}
+
+
 int Socket_fs::Plugin::close(File_descriptor *fd)
 {
 	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
@@ -21,6 +21,11 @@
 /* libc includes */
 extern "C" {
 #include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <libc_private.h>
 }
 
@@ -241,3 +246,98 @@ __SYS_(int, socket, (int domain, int type, int protocol),
 
 	return new_fdo->libc_fd;
 })
+
+
+/*************************
+ ** Zero-copy transfers **
+ *************************/
+
+/*
+ * In contrast to FreeBSD, 's' may refer to any file of the VFS plugin, e.g.,
+ * a pipe or another file, not only to a socket. The 'flags' are ignored.
+ */
+__SYS_(int, sendfile, (int libc_fd, int s, ::off_t offset, ::size_t nbytes,
+                       struct sf_hdtr *hdtr, ::off_t *sbytes, int /* flags */),
+{
+	::off_t sent = 0;
+
+	auto result = [&] (int error) -> int
+	{
+		if (sbytes)
+			*sbytes = sent;
+
+		return error ? Errno(error) : 0;
+	};
+
+	/* write header or trailer vector, return error on short write */
+	auto write_iov = [&] (struct iovec const *iov, int iovcnt) -> int
+	{
+		if (!iov || iovcnt <= 0)
+			return 0;
+
+		::size_t length = 0;
+		for (int i = 0; i < iovcnt; i++)
+			length += iov[i].iov_len;
+
+		ssize_t const n = writev(s, iov, iovcnt);
+		if (n < 0)
+			return errno;
+
+		sent += n;
+		return ((::size_t)n < length) ? EAGAIN : 0;
+	};
+
+	File_descriptor * const in  = file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+	File_descriptor * const out = file_descriptor_allocator()->find_by_libc_fd(s);
+
+	if (!in || !in->plugin || !out || !out->plugin)
+		return result(EBADF);
+
+	struct stat st { };
+	if (offset < 0 || fstat(libc_fd, &st) != 0 || !S_ISREG(st.st_mode))
+		return result(EINVAL);
+
+	File_descriptor * const in_file  = in->plugin->data_file(in);
+	File_descriptor * const out_file = out->plugin->data_file(out);
+
+	if (!out_file)
+		return result(ENOTCONN);
+
+	if (in_file != in || out_file->plugin != in->plugin)
+		return result(EINVAL);
+
+	bool const socket = (out_file != out);
+
+	::size_t const remaining = (st.st_size > offset) ? (::size_t)(st.st_size - offset) : 0;
+	::size_t const count     = nbytes ? Genode::min(nbytes, remaining) : remaining;
+
+	if (int const error = write_iov(hdtr ? hdtr->headers : nullptr,
+	                                hdtr ? hdtr->hdr_cnt : 0))
+		return result(error);
+
+	if (count) {
+
+		/* the data file of a socket is a stream at offset 0 */
+		if (socket)
+			lseek(out_file->libc_fd, 0, SEEK_SET);
+		else if (out->flags & O_APPEND)
+			lseek(s, 0, SEEK_END);
+
+		ssize_t const n = in->plugin->transfer(in, offset, out_file, count);
+
+		/* like 'send', report write errors of sockets as EPIPE */
+		if (n < 0)
+			return result((socket && errno == EIO) ? EPIPE : errno);
+
+		sent += n;
+
+		if ((::size_t)n < count && (out_file->flags & O_NONBLOCK))
+			return result(EAGAIN);
+	}
+
+	if (int const error = write_iov(hdtr ? hdtr->trailers : nullptr,
+	                                hdtr ? hdtr->trl_cnt : 0))
+		return result(error);
+
+	return result(0);
+})
@@ -165,6 +165,31 @@ namespace Libc {
 
 		return handle->fs().write_ready(*handle);
 	}
+
+	Vfs::Read_ready_response_handler *read_ready_handler_from_kernel(File_descriptor *fd)
+	{
+		Vfs::Read_ready_response_handler *result = nullptr;
+
+		if (Vfs::Vfs_handle const *handle = vfs_handle(fd))
+			handle->apply_handler([&] (Vfs::Read_ready_response_handler &handler) {
+				result = &handler; });
+
+		return result;
+	}
+
+	void read_ready_handler_from_kernel(File_descriptor *fd,
+	                                    Vfs::Read_ready_response_handler *handler)
+	{
+		if (Vfs::Vfs_handle *handle = vfs_handle(fd))
+			handle->handler(handler);
+	}
+
+	Vfs::Vfs_handle *vfs_handle_from_kernel(File_descriptor *fd)
+	{
+		return vfs_handle(fd);
+	}
+
+	bool aio_pending_from_kernel(File_descriptor *);
 }
 
 
@@ -549,6 +574,11 @@ int Libc::Vfs_plugin::close(File_descriptor *fd)
 	Sync sync { *handle, { .update_mtime = _config.update_mtime }, _current_real_time };
 
 	monitor().monitor([&] {
+
+		/* the handle must outlive the asynchronous requests referring to it */
+		if (aio_pending_from_kernel(fd))
+			return Fn::INCOMPLETE;
+
 		if ((fd->modified) || (fd->flags & O_CREAT))
 			if (!sync.complete())
 				return Fn::INCOMPLETE;
@@ -944,6 +974,203 @@ ssize_t Libc::Vfs_plugin::read(File_descriptor *fd, void *buf,
 }
 
 
+/*
+ * The content of a file that covers the whole transfer is written directly
+ * from the file dataspace, e.g., of a RAM or ROM file, to 'out'. Otherwise,
+ * the content is passed chunk-wise through a buffer, which still saves the
+ * round trips to the application. Both variants are executed in one visit
+ * of the kernel context.
+ */
+ssize_t Libc::Vfs_plugin::transfer(File_descriptor *in, ::off_t offset,
+                                   File_descriptor *out, ::size_t count)
+{
+	using Stat_result  = Vfs::Directory_service::Stat_result;
+	using Read_result  = Vfs::File_io_service::Read_result;
+	using Write_result = Vfs::File_io_service::Write_result;
+
+	if ((in->flags  & O_ACCMODE) == O_WRONLY
+	 || (out->flags & O_ACCMODE) == O_RDONLY)
+		return Errno(EBADF);
+
+	if ((in->flags | out->flags) & O_DIRECTORY)
+		return Errno(EISDIR);
+
+	if (offset < 0)
+		return Errno(EINVAL);
+
+	Vfs::Vfs_handle &src = *vfs_handle(in);
+	Vfs::Vfs_handle &dst = *vfs_handle(out);
+
+	/*
+	 * Transfer directly from the file dataspace only if the file system
+	 * provides it without copying the file content. Otherwise, the copy
+	 * would be an additional pass over the whole file.
+	 */
+	Genode::Dataspace_capability ds_cap { };
+	::size_t                     length = 0;
+
+	if (in->fd_path && offset == 0)
+		monitor().monitor([&] {
+			if (!_root_fs.dataspace_without_copy(in->fd_path))
+				return Fn::COMPLETE;
+
+			Vfs::Directory_service::Stat stat { };
+			if (_root_fs.stat(in->fd_path, stat) != Stat_result::STAT_OK)
+				return Fn::COMPLETE;
+
+			length = (::size_t)stat.size;
+			if (length && (count == 0 || count >= length))
+				ds_cap = _root_fs.dataspace(in->fd_path);
+
+			return Fn::COMPLETE;
+		});
+
+	char const *content = nullptr;
+
+	if (ds_cap.valid())
+		content = local_rm().attach(ds_cap, {
+			.size       = { },
+			.offset     = { },
+			.use_at     = { },
+			.at         = { },
+			.executable = { },
+			.writeable  = false
+		}).convert<char const *>(
+			[&] (Env::Local_rm::Attachment &a) {
+				a.deallocate = false;
+				return (char const *)a.ptr; },
+			[&] (Env::Local_rm::Error) { return nullptr; });
+
+	::size_t const buf_size = count ? min(count, (::size_t)64*1024) : 64*1024;
+
+	char * const buf = content ? nullptr : (char *)_alloc.alloc(buf_size);
+
+	enum class State { READ, READ_QUEUED, WRITE };
+
+	State state = content ? State::WRITE : State::READ;
+
+	bool const nonblocking = out->flags & O_NONBLOCK;
+
+	Vfs::file_size const initial_seek = src.seek();
+
+	::size_t    total      = 0;   /* bytes written to 'out' */
+	char const *chunk      = content;
+	::size_t    chunk_len  = content ? length : 0;
+	::size_t    chunk_done = 0;
+	int         error      = 0;
+
+	auto chunk_size = [&] {
+		return count ? min(count - total, buf_size) : buf_size; };
+
+	monitor().monitor([&] {
+		for (;;) {
+			switch (state) {
+
+			case State::READ:
+
+				if (count && total == count)
+					return Fn::COMPLETE;
+
+				src.seek((Vfs::file_size)offset + total);
+				if (!src.fs().queue_read(&src, chunk_size()))
+					return Fn::INCOMPLETE;
+
+				state = State::READ_QUEUED;
+				continue;
+
+			case State::READ_QUEUED:
+			{
+				Byte_range_ptr const dst_buf { buf, chunk_size() };
+
+				src.seek((Vfs::file_size)offset + total);
+				Read_result const result = src.fs().complete_read(&src, dst_buf, chunk_len);
+
+				switch (result) {
+				case Read_result::READ_QUEUED:          return Fn::INCOMPLETE;
+				case Read_result::READ_ERR_WOULD_BLOCK: error = EAGAIN; return Fn::COMPLETE;
+				case Read_result::READ_ERR_INVALID:     error = EINVAL; return Fn::COMPLETE;
+				case Read_result::READ_ERR_IO:          error = EIO;    return Fn::COMPLETE;
+				case Read_result::READ_OK:              break;
+				}
+
+				/* end of file */
+				if (chunk_len == 0)
+					return Fn::COMPLETE;
+
+				chunk      = buf;
+				chunk_done = 0;
+				state      = State::WRITE;
+				continue;
+			}
+
+			case State::WRITE:
+			{
+				Const_byte_range_ptr const src_buf { chunk + chunk_done,
+				                                     chunk_len - chunk_done };
+				::size_t out_count = 0;
+
+				Write_result const result = dst.fs().write(&dst, src_buf, out_count);
+
+				switch (result) {
+				case Write_result::WRITE_ERR_WOULD_BLOCK: break;
+				case Write_result::WRITE_ERR_INVALID:     error = EINVAL; return Fn::COMPLETE;
+				case Write_result::WRITE_ERR_IO:          error = EIO;    return Fn::COMPLETE;
+				case Write_result::WRITE_OK:              break;
+				}
+
+				if (out_count == 0) {
+					if (!nonblocking)
+						return Fn::INCOMPLETE;
+
+					error = EAGAIN;
+					return Fn::COMPLETE;
+				}
+
+				dst.advance_seek(out_count);
+				total      += out_count;
+				chunk_done += out_count;
+
+				if (chunk_done < chunk_len)
+					continue;
+
+				if (content)
+					return Fn::COMPLETE;
+
+				state = State::READ;
+				continue;
+			}
+			}
+		}
+	});
+
+	src.seek(initial_seek);
+
+	if (buf)
+		_alloc.free(buf, buf_size);
+
+	if (content)
+		local_rm().detach(addr_t(content));
+
+	/* the file may have been renamed meanwhile, so release it via its handle */
+	if (ds_cap.valid())
+		monitor().monitor([&] {
+			src.ds().release(in->fd_path, ds_cap);
+			return Fn::COMPLETE;
+		});
+
+	Plugin::resume_all();
+
+	if (total)
+		out->modified = true;
+
+	/* report the progress made before a failure */
+	if (error && !total)
+		return Errno(error);
+
+	return (ssize_t)total;
+}
+
+
 ssize_t Libc::Vfs_plugin::getdirentries(File_descriptor *fd, char *buf,
                                         ::size_t nbytes, ::off_t *basep)
 {
@@ -2289,6 +2516,82 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 }
 
 
+void *Libc::Vfs_plugin::_mmap_file_dataspace(::size_t length, File_descriptor &fd,
+                                              ::off_t offset)
+{
+	/*
+	 * A file system may hand out a copy of the whole file as dataspace,
+	 * which pays off only if the mapping covers the whole file.
+	 */
+	bool worthwhile = false;
+
+	monitor().monitor([&] {
+		Vfs::Directory_service::Stat stat { };
+
+		worthwhile = _root_fs.dataspace_without_copy(fd.fd_path)
+		          || (offset == 0
+		           && _root_fs.stat(fd.fd_path, stat) == Vfs::Directory_service::STAT_OK
+		           && length >= stat.size);
+		return Fn::COMPLETE;
+	});
+
+	if (!worthwhile)
+		return nullptr;
+
+	/*
+	 * Keep the file open while mapped and release the dataspace at the file
+	 * system of the handle, which is not affected by renaming the file.
+	 */
+	Vfs::Vfs_handle *reference_handle = nullptr;
+	Genode::Dataspace_capability ds_cap;
+
+	monitor().monitor([&] {
+		if (_root_fs.open(fd.fd_path, Vfs::Directory_service::OPEN_MODE_RDONLY,
+		                  &reference_handle, _alloc) == Vfs::Directory_service::OPEN_OK)
+			ds_cap = _root_fs.dataspace(fd.fd_path);
+		return Fn::COMPLETE;
+	});
+
+	auto release = [&] {
+		monitor().monitor([&] {
+			if (ds_cap.valid())
+				reference_handle->ds().release(fd.fd_path, ds_cap);
+			if (reference_handle)
+				reference_handle->close();
+			return Fn::COMPLETE;
+		});
+	};
+
+	if (!ds_cap.valid()) {
+		release();
+		return nullptr;
+	}
+
+	/* fails if the mapping exceeds the dataspace, e.g., beyond end of file */
+	void * const addr = local_rm().attach(ds_cap, {
+		.size       = length,
+		.offset     = addr_t(offset),
+		.use_at     = { },
+		.at         = { },
+		.executable = { },
+		.writeable  = false
+	}).convert<void *>(
+		[&] (Env::Local_rm::Attachment &a) { a.deallocate = false; return a.ptr; },
+		[&] (Env::Local_rm::Error)         { return nullptr; }
+	);
+
+	if (!addr) {
+		release();
+		return nullptr;
+	}
+
+	new (_alloc) Mmap_entry(_mmap_registry, addr, reference_handle, ds_cap,
+	                        Absolute_path(fd.fd_path));
+
+	return addr;
+}
+
+
 void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
                              File_descriptor *fd, ::off_t offset)
 {
@@ -2309,10 +2612,18 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 	if (flags & MAP_PRIVATE) {
 
 		/*
-		 * XXX attempt to obtain memory mapping via
-		 *     'Vfs::Directory_service::dataspace'.
+		 * A read-only private mapping cannot observe modifications, so it
+		 * is backed by the file dataspace if the file system provides one.
+		 * The pages are thereby populated on access and shared with other
+		 * processes mapping the same file, e.g., a ROM module.
 		 */
+		if (prot == PROT_READ) {
+			addr = _mmap_file_dataspace(length, *fd, offset);
+			if (addr)
+				return addr;
+		}
 
+		/* copy the file content into anonymous memory */
 		addr = mem_alloc()->alloc(length, PAGE_SHIFT);
 		if (addr == (void *)-1) {
 			error("mmap out of memory");
@@ -2422,13 +2733,18 @@ int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 	if (size_at_result == Size_at_error::MISMATCHING_ADDR)
 		return Errno(EINVAL);
 
-	/* shared mapping */
+	/* shared mapping or read-only private mapping of a file dataspace */
 
 	Vfs::Vfs_handle *reference_handle = nullptr;
 
+	Genode::Dataspace_capability file_ds { };
+	Absolute_path                path    { };
+
 	_mmap_registry.for_each([&] (Mmap_entry &entry) {
 		if (entry.start == addr) {
 			reference_handle = entry.reference_handle;
+			file_ds          = entry.file_ds;
+			path             = entry.path;
 			destroy(_alloc, &entry);
 			local_rm().detach(addr_t(addr));
 		}
@@ -2438,6 +2754,9 @@ int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 		return Errno(EINVAL);
 
 	monitor().monitor([&] {
+		if (file_ds.valid())
+			reference_handle->ds().release(path.string(), file_ds);
+
 		reference_handle->close();
 		return Fn::COMPLETE;
 	});
@@ -27,9 +27,11 @@
 
 /* Genode includes */
 #include <lwip_genode_init.h>
+#include <tcp_gro.h>
 #include <nic/packet_allocator.h>
 #include <nic_session/connection.h>
 #include <base/log.h>
+#include <util/fifo.h>
 
 namespace Lwip {
 
@@ -112,6 +114,108 @@ class Lwip::Nic_netif
 
 		bool _dhcp { false };
 
+		bool    _gro_enabled { true };
+		Tcp_gro _gro { };
+
+		void _input(pbuf *p)
+		{
+			if (_netif.input(p, &_netif) != ERR_OK) {
+				Genode::error("error forwarding Nic packet to lwIP");
+				pbuf_free(p);
+			}
+		}
+
+	public:
+
+		/**
+		 * Transmit buffer for zero-copy TCP payload
+		 *
+		 * The payload is placed in a packet of the Nic transmit buffer
+		 * behind a headroom that takes the protocol headers when the
+		 * payload is sent. The buffer stays allocated while it is used by
+		 * the owner, i.e., while lwIP references the payload, or while it
+		 * is submitted to the Nic server.
+		 */
+		struct Tx_buffer : Genode::Fifo<Tx_buffer>::Element
+		{
+			Nic::Packet_descriptor packet { };
+
+			char  *payload = nullptr;
+			u16_t  len     = 0;
+
+			/* sequence number of the first payload byte, set by the owner */
+			u32_t seqno = 0;
+
+			bool in_use    = false;
+			bool in_flight = false;
+		};
+
+		enum {
+			/*
+			 * Given Nic::Packet_allocator::OFFSET, the headroom aligns the
+			 * payload and thereby the IP header at 4 bytes
+			 */
+			TX_HEADROOM     = 128 - Nic::Packet_allocator::OFFSET,
+			TX_PAYLOAD_MAX  = Nic::Packet_allocator::OFFSET_PACKET_SIZE - TX_HEADROOM,
+		};
+
+	private:
+
+		enum {
+			NUM_TX_PACKETS = BUF_SIZE/PACKET_SIZE,
+
+			/* leave half of the transmit buffer to copied packets */
+			MAX_TX_BUFFERS = NUM_TX_PACKETS/2,
+		};
+
+		Tx_buffer _tx_buffers[NUM_TX_PACKETS] { };
+		unsigned  _num_tx_buffers = 0;
+
+		Tx_buffer &_tx_buffer(Nic::Packet_descriptor const &packet)
+		{
+			return _tx_buffers[(Genode::size_t)packet.offset()/PACKET_SIZE];
+		}
+
+		void _free_tx_buffer(Tx_buffer &buffer)
+		{
+			_nic.tx()->release_packet(buffer.packet);
+
+			buffer.packet  = Nic::Packet_descriptor();
+			buffer.payload = nullptr;
+			buffer.len     = 0;
+			buffer.in_use  = false;
+			_num_tx_buffers--;
+		}
+
+		/**
+		 * Release acknowledged packets
+		 *
+		 * \return true if any packet was acknowledged
+		 */
+		bool _flush_tx_acks()
+		{
+			auto &tx = *_nic.tx();
+
+			bool progress = false;
+
+			while (tx.ack_avail()) {
+				Nic::Packet_descriptor const packet = tx.try_get_acked_packet();
+
+				Tx_buffer &buffer = _tx_buffer(packet);
+				if (buffer.in_flight) {
+					buffer.in_flight = false;
+					if (!buffer.in_use)
+						_free_tx_buffer(buffer);
+				} else {
+					tx.release_packet(packet);
+				}
+
+				_tx_saturated = false;
+				progress = true;
+			}
+			return progress;
+		}
+
 	public:
 
 		void free_pbuf(Nic_netif_pbuf &pbuf)
@@ -182,12 +286,15 @@ class Lwip::Nic_netif
 					packet.size());
 				LINK_STATS_INC(link.recv);
 
-				if (_netif.input(p, &_netif) != ERR_OK) {
-					Genode::error("error forwarding Nic packet to lwIP");
-					pbuf_free(p);
-				}
+				if (_gro_enabled)
+					_gro.receive(p, [&] (pbuf *segment) { _input(segment); });
+				else
+					_input(p);
 			}
 
+			/* pass the last merged segment of the batch to lwIP */
+			_gro.flush([&] (pbuf *segment) { _input(segment); });
+
 			if (progress)
 				_wakeup_scheduler.schedule_nic_server_wakeup();
 		}
@@ -197,16 +304,7 @@ class Lwip::Nic_netif
 		 */
 		void handle_tx_ready()
 		{
-			auto &tx = *_nic.tx();
-
-			bool progress = false;
-
-			/* flush acknowledgements */
-			while (tx.ack_avail()) {
-				tx.release_packet(tx.try_get_acked_packet());
-				_tx_saturated = false;
-				progress = true;
-			}
+			bool const progress = _flush_tx_acks();
 
 			/* notify subclass to resume pending transmissions */
 			status_callback();
@@ -219,6 +317,8 @@ class Lwip::Nic_netif
 		{
 			_dhcp = config.attribute_value("dhcp", false);
 
+			_gro_enabled = config.attribute_value("gro", true);
+
 			using Str = Genode::String<IPADDR_STRLEN_MAX>;
 			Str ip_str = config.attribute_value("ip_addr", Str());
 
@@ -314,6 +414,62 @@ class Lwip::Nic_netif
 
 		bool tx_saturated() const { return _tx_saturated; }
 
+		/**
+		 * Allocate transmit buffer for 'len' bytes of payload
+		 *
+		 * \return  nullptr if no buffer is available, in which case the
+		 *          payload must be copied by lwIP
+		 */
+		Tx_buffer *alloc_tx_buffer(u16_t len)
+		{
+			if (!len || len > TX_PAYLOAD_MAX || _num_tx_buffers >= MAX_TX_BUFFERS)
+				return nullptr;
+
+			auto &tx = *_nic.tx();
+
+			_flush_tx_acks();
+
+			Nic::Packet_descriptor packet;
+			try { packet = tx.alloc_packet(TX_HEADROOM + len); }
+			catch (...) { return nullptr; }
+
+			Tx_buffer &buffer = _tx_buffer(packet);
+			buffer.packet  = packet;
+			buffer.payload = tx.packet_content(packet) + TX_HEADROOM;
+			buffer.len     = len;
+			buffer.in_use  = true;
+			_num_tx_buffers++;
+
+			return &buffer;
+		}
+
+		/**
+		 * Release transmit buffer once lwIP no longer references its payload
+		 */
+		void release_tx_buffer(Tx_buffer &buffer)
+		{
+			buffer.in_use = false;
+			if (!buffer.in_flight)
+				_free_tx_buffer(buffer);
+		}
+
+		/**
+		 * Return transmit buffer that contains 'ptr' or nullptr
+		 */
+		Tx_buffer *tx_buffer(void const *ptr)
+		{
+			auto &tx = *_nic.tx();
+
+			Genode::addr_t const base = (Genode::addr_t)tx.ds_local_base();
+			Genode::addr_t const addr = (Genode::addr_t)ptr;
+
+			if (addr < base || addr - base >= tx.ds_size())
+				return nullptr;
+
+			Tx_buffer &buffer = _tx_buffers[(addr - base)/PACKET_SIZE];
+			return buffer.in_use ? &buffer : nullptr;
+		}
+
 		/**
 		* Status callback to override in subclass
 		 */
@@ -376,11 +532,7 @@ class Lwip::Nic_netif
 		{
 			auto &tx = *_nic.tx();
 
-			/* flush acknowledgements */
-			while (tx.ack_avail()) {
-				tx.release_packet(tx.get_acked_packet());
-				_tx_saturated = false;
-			}
+			_flush_tx_acks();
 
 			if (!tx.ready_to_submit()) {
 				Genode::error("lwIP: Nic packet queue congested, cannot send packet");
@@ -388,6 +540,41 @@ class Lwip::Nic_netif
 				return ERR_WOULDBLOCK;
 			}
 
+			/*
+			 * If the frame ends with the payload of a transmit buffer, the
+			 * preceding headers are copied into the headroom of the buffer
+			 * and the payload is submitted in place. A buffer that is still
+			 * in flight, e.g., on retransmission, is copied instead.
+			 */
+			struct pbuf *last = p;
+			while (last->next)
+				last = last->next;
+
+			Tx_buffer *buffer = tx_buffer(last->payload);
+			Genode::size_t const hdr_len = p->tot_len - last->len;
+
+			if (buffer && !buffer->in_flight
+			 && last->payload == buffer->payload
+			 && last->len     <= buffer->len
+			 && hdr_len       <= TX_HEADROOM) {
+
+				char *dst = buffer->payload - hdr_len;
+				for (struct pbuf *q = p; q != last; q = q->next) {
+					Genode::memcpy(dst, q->payload, q->len);
+					dst += q->len;
+				}
+
+				Nic::Packet_descriptor const packet(
+					buffer->packet.offset() + TX_HEADROOM - hdr_len,
+					hdr_len + last->len);
+
+				buffer->in_flight = true;
+				tx.try_submit_packet(packet);
+				_wakeup_scheduler.schedule_nic_server_wakeup();
+				LINK_STATS_INC(link.xmit);
+				return ERR_OK;
+			}
+
 			Nic::Packet_descriptor packet;
 			try { packet = tx.alloc_packet(p->tot_len); }
 			catch (...) {
@@ -0,0 +1,285 @@
+/*
+ * \brief  Coalescing of received TCP segments
+ * \author agent
+ * \date   2026-10-19
+ *
+ * Consecutive in-order segments of a TCP connection that arrive within one
+ * batch of Nic packets are passed to lwIP as one segment, which saves the
+ * per-segment protocol processing and acknowledgements. Each constituent
+ * packet remains referenced by its own pbuf of the merged pbuf chain.
+ *
+ * The checksum of the merged segment is derived from the checksums of the
+ * constituent segments without touching the payload. If any constituent
+ * was corrupted, lwIP thus drops the merged segment.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef __LWIP__TCP_GRO_H__
+#define __LWIP__TCP_GRO_H__
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <util/string.h>
+
+namespace Lwip {
+
+extern "C" {
+#include <lwip/pbuf.h>
+}
+
+	class Tcp_gro;
+}
+
+
+class Lwip::Tcp_gro : Genode::Noncopyable
+{
+	private:
+
+		enum {
+			ETH_HDR_LEN = 14,
+			IP_HDR_LEN  = 20,
+			IP_LEN_MAX  = 0xffff,
+
+			TCP_FLAG_PSH = 0x08,
+			TCP_FLAG_ACK = 0x10,
+
+			/*
+			 * lwIP acknowledges every second segment regardless of its
+			 * size, which bounds the number of merged packets
+			 */
+			MAX_FRAMES = 8,
+		};
+
+		using uint8_t = Genode::uint8_t;
+		using size_t  = Genode::size_t;
+
+		static unsigned _get16(uint8_t const *p) { return (p[0] << 8) | p[1]; }
+
+		static u32_t _get32(uint8_t const *p) {
+			return ((u32_t)_get16(p) << 16) | _get16(p + 2); }
+
+		static void _put16(uint8_t *p, unsigned v) {
+			p[0] = (uint8_t)(v >> 8); p[1] = (uint8_t)v; }
+
+		/**
+		 * Ones-complement sum of 16-bit words in network byte order
+		 */
+		static u32_t _sum(uint8_t const *p, size_t len, u32_t sum = 0)
+		{
+			for (; len > 1; p += 2, len -= 2)
+				sum += _get16(p);
+
+			if (len)
+				sum += (u32_t)p[0] << 8;
+
+			return sum;
+		}
+
+		static unsigned _fold(u32_t sum)
+		{
+			while (sum >> 16)
+				sum = (sum & 0xffff) + (sum >> 16);
+			return (unsigned)sum;
+		}
+
+		/**
+		 * TCP segment within an Ethernet frame
+		 */
+		struct Segment
+		{
+			uint8_t *eth = nullptr;
+			uint8_t *ip  = nullptr;
+			uint8_t *tcp = nullptr;
+
+			size_t tcp_hdr_len = 0;
+			size_t payload_len = 0;
+
+			/* ones-complement sum of the payload derived from the checksum */
+			unsigned payload_sum = 0;
+
+			u32_t seq() const { return _get32(tcp + 4); }
+
+			bool psh() const { return tcp[13] & TCP_FLAG_PSH; }
+
+			size_t payload_offset() const {
+				return ETH_HDR_LEN + IP_HDR_LEN + tcp_hdr_len; }
+
+			u32_t pseudo_header_sum(size_t tcp_len) const {
+				return _sum(ip + 12, 8, 6 + (u32_t)tcp_len); }
+
+			/**
+			 * Parse frame of an untagged IPv4 TCP segment eligible for merging
+			 *
+			 * Segments with IP options, fragments, and segments carrying
+			 * anything else than payload and an acknowledgement are not
+			 * merged.
+			 */
+			bool parse(pbuf const &p)
+			{
+				if (p.len != p.tot_len || p.len < ETH_HDR_LEN + IP_HDR_LEN + 20)
+					return false;
+
+				eth = (uint8_t *)p.payload;
+				ip  = eth + ETH_HDR_LEN;
+				tcp = ip  + IP_HDR_LEN;
+
+				if (_get16(eth + 12) != 0x0800 || ip[0] != 0x45 || ip[9] != 6)
+					return false;
+
+				/* no more-fragments flag, no fragment offset */
+				if (_get16(ip + 6) & 0x3fff)
+					return false;
+
+				if (_fold(_sum(ip, IP_HDR_LEN)) != 0xffff)
+					return false;
+
+				size_t const ip_len = _get16(ip + 2);
+				if (ip_len > (size_t)p.len - ETH_HDR_LEN)
+					return false;
+
+				tcp_hdr_len = (size_t)(tcp[12] >> 4)*4;
+				if (tcp_hdr_len < 20 || IP_HDR_LEN + tcp_hdr_len >= ip_len)
+					return false;
+
+				if ((tcp[13] & ~TCP_FLAG_PSH) != TCP_FLAG_ACK)
+					return false;
+
+				size_t const tcp_len = ip_len - IP_HDR_LEN;
+				payload_len = tcp_len - tcp_hdr_len;
+
+				/*
+				 * The sum over pseudo header, TCP header, and payload of a
+				 * valid segment is 0xffff.
+				 */
+				payload_sum = ~_fold(_sum(tcp, tcp_hdr_len,
+				                          pseudo_header_sum(tcp_len))) & 0xffff;
+				return true;
+			}
+		};
+
+		pbuf    *_head = nullptr;
+		Segment  _head_segment { };
+
+		unsigned _frames      = 0;
+		size_t   _payload_len = 0;
+		u32_t    _payload_sum = 0;
+		u32_t    _next_seq    = 0;
+		bool     _psh         = false;
+
+		bool _mergeable(Segment const &s) const
+		{
+			Segment const &h = _head_segment;
+
+			/* TOS, TTL, acknowledgement, window, and options must be identical */
+			return _frames < MAX_FRAMES
+			    && !_psh
+			    && !(_payload_len & 1)
+			    && s.seq() == _next_seq
+			    && s.tcp_hdr_len == h.tcp_hdr_len
+			    && IP_HDR_LEN + h.tcp_hdr_len + _payload_len + s.payload_len <= IP_LEN_MAX
+			    && s.ip[1] == h.ip[1] && s.ip[8] == h.ip[8]
+			    && !Genode::memcmp(s.eth,      h.eth,      ETH_HDR_LEN)
+			    && !Genode::memcmp(s.ip  + 12, h.ip  + 12, 8)
+			    && !Genode::memcmp(s.tcp,      h.tcp,      4)
+			    && !Genode::memcmp(s.tcp + 8,  h.tcp + 8,  4)
+			    && !Genode::memcmp(s.tcp + 14, h.tcp + 14, 2)
+			    && !Genode::memcmp(s.tcp + 20, h.tcp + 20, h.tcp_hdr_len - 20);
+		}
+
+		/**
+		 * Update IP and TCP headers of the head segment for the merged payload
+		 */
+		void _finalize()
+		{
+			Segment &h = _head_segment;
+
+			size_t const tcp_len = h.tcp_hdr_len + _payload_len;
+
+			_put16(h.ip + 2,  (unsigned)(IP_HDR_LEN + tcp_len));
+			_put16(h.ip + 10, 0);
+			_put16(h.ip + 10, ~_fold(_sum(h.ip, IP_HDR_LEN)) & 0xffff);
+
+			if (_psh)
+				h.tcp[13] |= TCP_FLAG_PSH;
+
+			_put16(h.tcp + 16, 0);
+
+			u32_t const sum = _sum(h.tcp, h.tcp_hdr_len,
+			                       h.pseudo_header_sum(tcp_len)) + _payload_sum;
+
+			_put16(h.tcp + 16, ~_fold(sum) & 0xffff);
+		}
+
+	public:
+
+		/**
+		 * Pass pending merged segment to 'input_fn'
+		 */
+		void flush(auto const &input_fn)
+		{
+			if (!_head)
+				return;
+
+			if (_frames > 1)
+				_finalize();
+
+			pbuf *p = _head;
+			_head   = nullptr;
+			_frames = 0;
+
+			input_fn(p);
+		}
+
+		/**
+		 * Receive frame
+		 *
+		 * The frame is either merged into the pending segment or passed to
+		 * 'input_fn' after flushing the pending segment.
+		 */
+		void receive(pbuf *p, auto const &input_fn)
+		{
+			Segment s { };
+			if (!s.parse(*p)) {
+				flush(input_fn);
+				input_fn(p);
+				return;
+			}
+
+			if (_head && !_mergeable(s))
+				flush(input_fn);
+
+			if (!_head) {
+				/* strip Ethernet padding */
+				pbuf_realloc(p, (u16_t)(s.payload_offset() + s.payload_len));
+
+				_head         = p;
+				_head_segment = s;
+				_frames       = 1;
+				_payload_len  = s.payload_len;
+				_payload_sum  = s.payload_sum;
+			} else {
+				pbuf_remove_header(p, s.payload_offset());
+				pbuf_realloc(p, (u16_t)s.payload_len);
+				pbuf_cat(_head, p);
+
+				_frames++;
+				_payload_len += s.payload_len;
+				_payload_sum += s.payload_sum;
+			}
+
+			_next_seq = s.seq() + (u32_t)s.payload_len;
+			_psh      = s.psh();
+
+			/* like the sender, deliver pushed data without delay */
+			if (_psh)
+				flush(input_fn);
+		}
+};
+
+#endif /* __LWIP__TCP_GRO_H__ */
@@ -34,6 +34,7 @@ namespace Lwip {
 extern "C" {
 #include <lwip/udp.h>
 #include <lwip/tcp.h>
+#include <lwip/priv/tcp_priv.h>
 #include <lwip/dns.h>
 }
 
@@ -541,6 +542,7 @@ class Lwip::Protocol_dir_impl final : public Protocol_dir
 		Genode::Allocator  &_alloc;
 		Genode::Entrypoint &_ep;
 		Vfs::Env::User     &_vfs_user;
+		Nic_netif          &_netif;
 
 		Genode::List<SOCKET_DIR> _socket_dirs { };
 
@@ -552,8 +554,11 @@ class Lwip::Protocol_dir_impl final : public Protocol_dir
 		friend class Tcp_socket_dir;
 		friend class Udp_socket_dir;
 
-		Protocol_dir_impl(Vfs::Env &env)
-		: _alloc(env.alloc()), _ep(env.env().ep()), _vfs_user(env.user()) { }
+		Protocol_dir_impl(Vfs::Env &env, Nic_netif &netif)
+		:
+			_alloc(env.alloc()), _ep(env.env().ep()), _vfs_user(env.user()),
+			_netif(netif)
+		{ }
 
 		SOCKET_DIR *lookup(char const *name)
 		{
@@ -1113,6 +1118,163 @@ class Lwip::Tcp_socket_dir final :
 		/* queue of received data */
 		pbuf *_recv_pbuf = nullptr;
 
+		using Tx_buffer = Nic_netif::Tx_buffer;
+
+		/* transmit buffers referenced by lwIP in sequence order */
+		Genode::Fifo<Tx_buffer> _tx_buffers { };
+
+		/**
+		 * Return free space of the last unsent segment
+		 */
+		u16_t _unsent_space() const
+		{
+			tcp_seg *seg = _pcb->unsent;
+			if (!seg)
+				return 0;
+
+			while (seg->next)
+				seg = seg->next;
+
+			return seg->len < tcp_mss(_pcb) ? tcp_mss(_pcb) - seg->len : 0;
+		}
+
+		/**
+		 * Queue up to one segment of data for transmission
+		 *
+		 * A full segment of data is copied into a transmit buffer of the
+		 * Nic session that lwIP references until the data is acknowledged
+		 * by the peer. Hence, the data is not copied again when the
+		 * segment is sent. Otherwise, lwIP copies the data. A partially
+		 * filled segment is completed first, which keeps the payload of
+		 * subsequent transmit buffers at the start of a segment.
+		 *
+		 * \param n  number of bytes to write, updated to the number of
+		 *           bytes written
+		 */
+		err_t _tcp_write(char const *src, u16_t &n)
+		{
+			u16_t const mss   = tcp_mss(_pcb);
+			u16_t const space = _unsent_space();
+
+			Tx_buffer *buffer = (n >= mss && !space)
+			                  ? _proto_dir._netif.alloc_tx_buffer(mss) : nullptr;
+			if (!buffer) {
+				if (space)
+					n = min(n, space);
+				return tcp_write(_pcb, src, n, TCP_WRITE_FLAG_COPY);
+			}
+
+			Genode::memcpy(buffer->payload, src, mss);
+			buffer->seqno = _pcb->snd_lbb;
+
+			err_t const err = tcp_write(_pcb, buffer->payload, mss, 0);
+			if (err != ERR_OK) {
+				_proto_dir._netif.release_tx_buffer(*buffer);
+				return err;
+			}
+
+			_tx_buffers.enqueue(*buffer);
+			n = mss;
+			return ERR_OK;
+		}
+
+		/**
+		 * Release transmit buffers that lwIP no longer references
+		 *
+		 * lwIP frees a segment only when it is acknowledged completely.
+		 * As the payload of a transmit buffer may be split across two
+		 * segments, a buffer is released once it lies completely before
+		 * the oldest segment still queued.
+		 */
+		void _release_acked_tx_buffers()
+		{
+			if (!_pcb)
+				return;
+
+			u32_t oldest = _pcb->snd_lbb;
+
+			tcp_seg * const queues[] = { _pcb->unacked, _pcb->unsent };
+
+			for (tcp_seg *seg : queues)
+				if (seg && TCP_SEQ_LT(lwip_ntohl(seg->tcphdr->seqno), oldest))
+					oldest = lwip_ntohl(seg->tcphdr->seqno);
+
+			for (bool done = false; !done; ) {
+				done = true;
+				_tx_buffers.head([&] (Tx_buffer &buffer) {
+					if (TCP_SEQ_GT(buffer.seqno + buffer.len, oldest))
+						return;
+
+					_tx_buffers.remove(buffer);
+					_proto_dir._netif.release_tx_buffer(buffer);
+					done = false;
+				});
+			}
+		}
+
+		void _release_all_tx_buffers()
+		{
+			_tx_buffers.dequeue_all([&] (Tx_buffer &buffer) {
+				_proto_dir._netif.release_tx_buffer(buffer); });
+		}
+
+		/**
+		 * Detach queued segments from the transmit buffers
+		 *
+		 * Once the pcb is closed, lwIP keeps sending the queued data
+		 * without the socket. Therefore, the payload still referenced in
+		 * transmit buffers is copied to lwIP memory.
+		 *
+		 * \return false if memory for the copies is exhausted
+		 */
+		bool _detach_tx_buffers()
+		{
+			/* a listening pcb lacks the segment queues */
+			if (_pcb->state == LISTEN)
+				return true;
+
+			tcp_seg * const queues[] = { _pcb->unacked, _pcb->unsent };
+
+			for (tcp_seg *queue : queues) {
+				for (tcp_seg *seg = queue; seg; seg = seg->next) {
+					for (pbuf *q = seg->p; q->next; q = q->next) {
+
+						pbuf *rom = q->next;
+						if (!_proto_dir._netif.tx_buffer(rom->payload))
+							continue;
+
+						pbuf *ram = pbuf_alloc(PBUF_RAW, rom->len, PBUF_RAM);
+						if (!ram)
+							return false;
+
+						Genode::memcpy(ram->payload, rom->payload, rom->len);
+						ram->tot_len = rom->tot_len;
+						ram->next    = rom->next;
+						q->next      = ram;
+
+						rom->next = nullptr;
+						pbuf_free(rom);
+					}
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * Close the pcb, which lwIP frees once the queued data is sent
+		 */
+		void _close_pcb()
+		{
+			tcp_arg(_pcb, NULL);
+
+			if (_detach_tx_buffers())
+				tcp_close(_pcb);
+			else
+				tcp_abort(_pcb);
+
+			_release_all_tx_buffers();
+		}
+
 		Open_result _accept_new_socket(Vfs::File_system &fs,
                                        Genode::Allocator &alloc,
                                        Vfs::Vfs_handle **out_handle) override
@@ -1164,10 +1326,8 @@ class Lwip::Tcp_socket_dir final :
 				destroy(alloc, p);
 			}
 
-			if (_pcb != NULL) {
-				tcp_arg(_pcb, NULL);
-				tcp_close(_pcb);
-			}
+			if (_pcb != NULL)
+				_close_pcb();
 
 			_proto_dir.release(this);
 		}
@@ -1219,6 +1379,9 @@ class Lwip::Tcp_socket_dir final :
 			state = CLOSED;
 			_pcb = NULL;
 
+			/* lwIP freed the segments along with the pcb */
+			_release_all_tx_buffers();
+
 			/* churn the application */
 			wakeup_vfs_user();
 			process_read_ready();
@@ -1229,6 +1392,15 @@ class Lwip::Tcp_socket_dir final :
 			_vfs_user.wakeup_vfs_user();
 		}
 
+		/**
+		 * Handle data acknowledged by the peer
+		 */
+		void sent()
+		{
+			_release_acked_tx_buffers();
+			wakeup_vfs_user();
+		}
+
 		/**
 		 * Close the connection
 		 *
@@ -1241,8 +1413,7 @@ class Lwip::Tcp_socket_dir final :
 				return;
 
 			if (_pcb) {
-				tcp_arg(_pcb, NULL);
-				tcp_close(_pcb);
+				_close_pcb();
 				state = CLOSED;
 				_pcb = NULL;
 			}
@@ -1490,7 +1661,7 @@ class Lwip::Tcp_socket_dir final :
 						u16_t n = min(count, tcp_sndbuf(_pcb));
 
 						/* queue data to outgoing TCP buffer */
-						err_t err = tcp_write(_pcb, src_ptr, n, TCP_WRITE_FLAG_COPY);
+						err_t err = _tcp_write(src_ptr, n);
 						if (err != ERR_OK) {
 							Genode::error("lwIP: tcp_write failed, error ", (int)-err);
 							res = Write_result::WRITE_ERR_IO;
@@ -1699,7 +1870,7 @@ err_t tcp_sent_callback(void *arg, struct tcp_pcb *pcb, u16_t)
 	}
 
 	Lwip::Tcp_socket_dir *socket_dir = static_cast<Lwip::Tcp_socket_dir *>(arg);
-	socket_dir->wakeup_vfs_user();
+	socket_dir->sent();
 	return ERR_OK;
 }
 
@@ -1761,8 +1932,8 @@ class Lwip::File_system final : public Vfs::File_system, public Lwip::Directory,
 		{
 			Vfs::Env &_vfs_env;
 
-			Tcp_proto_dir tcp_dir { _vfs_env };
-			Udp_proto_dir udp_dir { _vfs_env };
+			Tcp_proto_dir tcp_dir { _vfs_env, *this };
+			Udp_proto_dir udp_dir { _vfs_env, *this };
 
 			Nameserver_registry nameserver_handles { };
 
@@ -0,0 +1,196 @@
+/*
+ * \brief  Test for POSIX asynchronous I/O
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The file test writes and reads a RAM file in chunks with all requests in
+ * flight at once. The pipe test covers requests that wait for data, the
+ * submission order of requests referring to the same file, timeouts of
+ * 'aio_suspend', and cancellation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <aio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+enum { CHUNK = 4096, NUM_CHUNKS = 64 };
+
+static char file_data[NUM_CHUNKS][CHUNK];
+static char read_data[NUM_CHUNKS][CHUNK];
+
+
+static void check(bool condition, char const *msg)
+{
+	if (condition)
+		return;
+
+	printf("Error: %s (errno=%d)\n", msg, errno);
+	exit(-1);
+}
+
+
+/**
+ * Wait for completion of request and return its result
+ */
+static ssize_t wait_for(aiocb &cb)
+{
+	aiocb const * const list[] = { &cb };
+
+	while (aio_error(&cb) == EINPROGRESS)
+		check(aio_suspend(list, 1, nullptr) == 0, "aio_suspend failed");
+
+	return aio_return(&cb);
+}
+
+
+static void test_file()
+{
+	int const fd = open("/tmp/file", O_RDWR | O_CREAT, 0644);
+	check(fd >= 0, "open failed");
+
+	for (unsigned i = 0; i < NUM_CHUNKS; i++)
+		memset(file_data[i], 'a' + (i % 26), CHUNK);
+
+	static aiocb cbs[NUM_CHUNKS];
+
+	/* write all chunks in batches of 'lio_listio' */
+	for (unsigned i = 0; i < NUM_CHUNKS; i += AIO_LISTIO_MAX) {
+
+		aiocb *list[AIO_LISTIO_MAX] { };
+
+		for (unsigned j = 0; j < AIO_LISTIO_MAX; j++) {
+			aiocb &cb = cbs[i + j];
+			cb = { };
+			cb.aio_fildes     = fd;
+			cb.aio_offset     = (off_t)(i + j)*CHUNK;
+			cb.aio_buf        = file_data[i + j];
+			cb.aio_nbytes     = CHUNK;
+			cb.aio_lio_opcode = LIO_WRITE;
+			list[j] = &cb;
+		}
+
+		check(lio_listio(LIO_WAIT, list, AIO_LISTIO_MAX, nullptr) == 0,
+		      "lio_listio failed");
+
+		for (unsigned j = 0; j < AIO_LISTIO_MAX; j++)
+			check(aio_return(&cbs[i + j]) == CHUNK, "short write");
+	}
+
+	/* the file offset is not affected by asynchronous I/O */
+	check(lseek(fd, 0, SEEK_CUR) == 0, "file offset changed");
+
+	/* read all chunks in reverse order with all requests in flight */
+	struct timespec start { }, end { };
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (unsigned i = NUM_CHUNKS; i-- > 0; ) {
+		aiocb &cb = cbs[i];
+		cb = { };
+		cb.aio_fildes = fd;
+		cb.aio_offset = (off_t)i*CHUNK;
+		cb.aio_buf    = read_data[i];
+		cb.aio_nbytes = CHUNK;
+		check(aio_read(&cb) == 0, "aio_read failed");
+	}
+
+	for (unsigned i = 0; i < NUM_CHUNKS; i++)
+		check(wait_for(cbs[i]) == CHUNK, "short read");
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	check(memcmp(file_data, read_data, sizeof(file_data)) == 0, "data mismatch");
+
+	unsigned long const us = (unsigned long)((end.tv_sec - start.tv_sec)*1000000
+	                                       + (end.tv_nsec - start.tv_nsec)/1000);
+	printf("read %u chunks of %u bytes in %lu us\n",
+	       (unsigned)NUM_CHUNKS, (unsigned)CHUNK, us);
+
+	/* requests for read-only access are rejected on submission */
+	aiocb cb { };
+	cb.aio_fildes = open("/tmp/file", O_RDONLY);
+	cb.aio_buf    = file_data[0];
+	cb.aio_nbytes = CHUNK;
+	check(aio_write(&cb) == -1 && errno == EBADF, "write to read-only file");
+
+	close(cb.aio_fildes);
+	close(fd);
+}
+
+
+static void test_pipe()
+{
+	int fds[2];
+	check(pipe(fds) == 0, "pipe failed");
+
+	char buf[2][16] { };
+
+	aiocb first { }, second { };
+	first.aio_fildes  = second.aio_fildes = fds[0];
+	first.aio_buf     = buf[0];
+	second.aio_buf    = buf[1];
+	first.aio_nbytes  = second.aio_nbytes = 5;
+
+	check(aio_read(&first)  == 0, "aio_read failed");
+	check(aio_read(&second) == 0, "aio_read failed");
+
+	/* no data available yet */
+	aiocb const * const list[] = { &first };
+	struct timespec const timeout { 0, 100*1000*1000 };
+	check(aio_suspend(list, 1, &timeout) == -1 && errno == EAGAIN,
+	      "aio_suspend did not time out");
+	check(aio_error(&first) == EINPROGRESS, "read completed without data");
+
+	/* the second request waits for the first and can be canceled */
+	check(aio_cancel(fds[0], &second) == AIO_CANCELED, "aio_cancel failed");
+	check(aio_error(&second) == ECANCELED, "request not canceled");
+	check(aio_return(&second) == -1 && errno == ECANCELED, "aio_return failed");
+
+	/* writes to the same file are executed in the order of submission */
+	char const *words[] = { "hello", "world" };
+	aiocb writes[2] { };
+	for (unsigned i = 0; i < 2; i++) {
+		writes[i].aio_fildes = fds[1];
+		writes[i].aio_buf    = (void *)words[i];
+		writes[i].aio_nbytes = 5;
+		check(aio_write(&writes[i]) == 0, "aio_write failed");
+	}
+
+	for (unsigned i = 0; i < 2; i++)
+		check(wait_for(writes[i]) == 5, "short write to pipe");
+
+	check(wait_for(first) == 5 && memcmp(buf[0], "hello", 5) == 0,
+	      "unexpected pipe data");
+
+	second.aio_buf = buf[1];
+	check(aio_read(&second) == 0, "aio_read failed");
+	check(wait_for(second) == 5 && memcmp(buf[1], "world", 5) == 0,
+	      "unexpected pipe data");
+
+	close(fds[0]);
+	close(fds[1]);
+}
+
+
+int main(int, char **)
+{
+	printf("--- test-libc_aio started ---\n");
+
+	test_file();
+	test_pipe();
+
+	printf("--- test-libc_aio finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_aio
+SRC_CC = main.cc
+LIBS   = posix
@@ -0,0 +1,189 @@
+/*
+ * \brief  Benchmark for epoll_wait and poll with many idle file descriptors
+ * \author agent
+ * \date   2026-10-19
+ *
+ * A number of idle pipes is watched together with a few active pipes. In
+ * each round, one byte is written to every active pipe and the readiness
+ * of all active pipes is collected before the bytes are consumed. The cost
+ * of 'poll' grows with the number of watched file descriptors whereas the
+ * cost of 'epoll_wait' depends on the number of ready ones.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <sys/epoll.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+enum { MAX_PIPES = 512, MAX_EVENTS = 64 };
+
+static int      pipes[MAX_PIPES][2];
+static pollfd   pollfds[MAX_PIPES];
+static unsigned num_pipes;
+static unsigned num_active;
+static unsigned rounds = 1000;
+
+
+static uint64_t now_us()
+{
+	timespec ts { };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000*1000 + (uint64_t)ts.tv_nsec/1000;
+}
+
+
+/*
+ * The active pipes are the last ones, so 'poll' must traverse all idle
+ * pipes before reaching them.
+ */
+static bool active(unsigned i) { return i >= num_pipes - num_active; }
+
+
+static void write_active()
+{
+	for (unsigned i = num_pipes - num_active; i < num_pipes; i++)
+		if (write(pipes[i][1], "x", 1) != 1) {
+			printf("Error: write to pipe %u failed\n", i);
+			exit(-1);
+		}
+}
+
+
+static void consume(unsigned i)
+{
+	char c;
+	if (!active(i) || read(pipes[i][0], &c, 1) != 1) {
+		printf("Error: unexpected readiness of pipe %u\n", i);
+		exit(-1);
+	}
+}
+
+
+static void run_epoll()
+{
+	int const epfd = epoll_create1(0);
+	if (epfd < 0) {
+		printf("Error: epoll_create1 failed\n");
+		exit(-1);
+	}
+
+	for (unsigned i = 0; i < num_pipes; i++) {
+		epoll_event event { };
+		event.events   = EPOLLIN;
+		event.data.u32 = i;
+
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, pipes[i][0], &event) != 0) {
+			printf("Error: epoll_ctl failed for pipe %u\n", i);
+			exit(-1);
+		}
+	}
+
+	epoll_event events[MAX_EVENTS];
+
+	uint64_t const start_us = now_us();
+
+	for (unsigned r = 0; r < rounds; r++) {
+
+		write_active();
+
+		for (unsigned pending = num_active; pending; ) {
+			int const n = epoll_wait(epfd, events, MAX_EVENTS, -1);
+			if (n <= 0) {
+				printf("Error: epoll_wait returned %d\n", n);
+				exit(-1);
+			}
+			for (int j = 0; j < n; j++)
+				consume(events[j].data.u32);
+
+			pending -= (unsigned)n;
+		}
+	}
+
+	uint64_t const duration_us = now_us() - start_us;
+
+	close(epfd);
+
+	printf("epoll  idle=%-4u active=%-3u %u rounds in %llu us (%llu us per round)\n",
+	       num_pipes - num_active, num_active, rounds,
+	       (unsigned long long)duration_us,
+	       (unsigned long long)(duration_us/rounds));
+}
+
+
+static void run_poll()
+{
+	for (unsigned i = 0; i < num_pipes; i++)
+		pollfds[i] = { .fd = pipes[i][0], .events = POLLIN, .revents = 0 };
+
+	uint64_t const start_us = now_us();
+
+	for (unsigned r = 0; r < rounds; r++) {
+
+		write_active();
+
+		for (unsigned pending = num_active; pending; ) {
+			int const n = poll(pollfds, num_pipes, -1);
+			if (n <= 0) {
+				printf("Error: poll returned %d\n", n);
+				exit(-1);
+			}
+			for (unsigned i = 0; i < num_pipes; i++)
+				if (pollfds[i].revents & POLLIN)
+					consume(i);
+
+			pending -= (unsigned)n;
+		}
+	}
+
+	uint64_t const duration_us = now_us() - start_us;
+
+	printf("poll   idle=%-4u active=%-3u %u rounds in %llu us (%llu us per round)\n",
+	       num_pipes - num_active, num_active, rounds,
+	       (unsigned long long)duration_us,
+	       (unsigned long long)(duration_us/rounds));
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned num_idle = 480;
+
+	num_active = 8;
+
+	if (argc > 1) num_idle   = (unsigned)atoi(argv[1]);
+	if (argc > 2) num_active = (unsigned)atoi(argv[2]);
+	if (argc > 3) rounds     = (unsigned)atoi(argv[3]);
+
+	num_pipes = num_idle + num_active;
+
+	if (!num_active || num_active > MAX_EVENTS || num_pipes > MAX_PIPES || !rounds) {
+		printf("Error: invalid arguments (at most %u pipes, 1...%u active)\n",
+		       (unsigned)MAX_PIPES, (unsigned)MAX_EVENTS);
+		return -1;
+	}
+
+	for (unsigned i = 0; i < num_pipes; i++)
+		if (pipe(pipes[i]) != 0) {
+			printf("Error: could not create pipe %u\n", i);
+			return -1;
+		}
+
+	printf("--- epoll benchmark started ---\n");
+
+	run_poll();
+	run_epoll();
+
+	printf("--- epoll benchmark finished ---\n");
+	return 0;
+}
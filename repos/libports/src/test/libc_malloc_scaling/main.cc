@@ -0,0 +1,174 @@
+/*
+ * \brief  Benchmark for malloc/free throughput with multiple threads
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The 'local' workload allocates and frees batches of objects within each
+ * thread. The 'remote' workload passes objects from producer threads to
+ * consumer threads, which free them.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+enum { MAX_THREADS = 16, BATCH = 64, RING_SIZE = 256 };
+
+static unsigned long iterations = 10000;
+
+
+static uint64_t now_us()
+{
+	timespec ts { };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000*1000 + (uint64_t)ts.tv_nsec/1000;
+}
+
+
+/**
+ * Mostly small objects with an occasional buffer of up to 16 KiB
+ */
+static size_t random_size(uint32_t &state)
+{
+	state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+
+	return (state & 3) ? 16 + (state >> 8) % 240
+	                   : 256 + (state >> 8) % (16*1024 - 256);
+}
+
+
+static void *local_worker(void *arg)
+{
+	uint32_t state = (uint32_t)(uintptr_t)arg + 1;
+	char *ptrs[BATCH];
+
+	for (unsigned long i = 0; i < iterations; i++) {
+		for (unsigned j = 0; j < BATCH; j++) {
+			ptrs[j] = (char *)malloc(random_size(state));
+			if (!ptrs[j])
+				abort();
+			ptrs[j][0] = (char)j;
+		}
+		for (unsigned j = 0; j < BATCH; j++)
+			free(ptrs[j]);
+	}
+	return nullptr;
+}
+
+
+/**
+ * Single-producer single-consumer ring of allocated objects
+ *
+ * Thread 2n produces into ring n, thread 2n+1 consumes from it.
+ */
+struct Ring
+{
+	void     *slots[RING_SIZE];
+	unsigned  head;   /* written by producer */
+	unsigned  tail;   /* written by consumer */
+};
+
+static Ring rings[MAX_THREADS/2];
+
+
+static void *producer(void *arg)
+{
+	Ring     &ring  = rings[(uintptr_t)arg/2];
+	uint32_t  state = (uint32_t)(uintptr_t)arg + 1;
+
+	for (unsigned long i = 0; i < iterations*BATCH; i++) {
+		void *ptr = malloc(random_size(state));
+		if (!ptr)
+			abort();
+
+		unsigned const head = ring.head;
+		while (head - __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE) == RING_SIZE)
+			sched_yield();
+
+		ring.slots[head % RING_SIZE] = ptr;
+		__atomic_store_n(&ring.head, head + 1, __ATOMIC_RELEASE);
+	}
+	return nullptr;
+}
+
+
+static void *consumer(void *arg)
+{
+	Ring &ring = rings[(uintptr_t)arg/2];
+
+	for (unsigned long i = 0; i < iterations*BATCH; i++) {
+
+		unsigned const tail = ring.tail;
+		while (__atomic_load_n(&ring.head, __ATOMIC_ACQUIRE) == tail)
+			sched_yield();
+
+		free(ring.slots[tail % RING_SIZE]);
+		__atomic_store_n(&ring.tail, tail + 1, __ATOMIC_RELEASE);
+	}
+	return nullptr;
+}
+
+
+static void run(char const *name, unsigned num_threads, unsigned long ops,
+                auto const &start_fn)
+{
+	pthread_t threads[MAX_THREADS];
+
+	uint64_t const start = now_us();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		if (pthread_create(&threads[i], nullptr, start_fn(i), (void *)(uintptr_t)i) != 0) {
+			printf("Error: pthread_create failed\n");
+			exit(-1);
+		}
+
+	for (unsigned i = 0; i < num_threads; i++)
+		pthread_join(threads[i], nullptr);
+
+	uint64_t const duration_us = now_us() - start;
+
+	printf("%-6s threads=%-2u %lu malloc/free pairs in %llu us (%llu per ms)\n",
+	       name, num_threads, ops, (unsigned long long)duration_us,
+	       (unsigned long long)(duration_us ? ops*1000/duration_us : 0));
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned max_threads = 8;
+
+	if (argc > 1) max_threads = (unsigned)atoi(argv[1]);
+	if (argc > 2) iterations  = (unsigned long)atol(argv[2]);
+
+	if (max_threads < 1 || max_threads > MAX_THREADS) {
+		printf("Error: number of threads must be within 1...%u\n", (unsigned)MAX_THREADS);
+		return -1;
+	}
+
+	printf("--- malloc scaling benchmark started ---\n");
+
+	for (unsigned n = 1; n <= max_threads; n *= 2)
+		run("local", n, iterations*BATCH*n,
+		    [] (unsigned) { return local_worker; });
+
+	for (unsigned n = 2; n <= max_threads; n *= 2) {
+		for (Ring &ring : rings)
+			ring = { };
+		run("remote", n, iterations*BATCH*n/2,
+		    [] (unsigned i) { return (i % 2) ? consumer : producer; });
+	}
+
+	printf("--- malloc scaling benchmark finished ---\n");
+	return 0;
+}
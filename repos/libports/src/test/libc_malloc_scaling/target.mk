@@ -0,0 +1,3 @@
+TARGET = test-libc_malloc_scaling
+SRC_CC = main.cc
+LIBS   = posix
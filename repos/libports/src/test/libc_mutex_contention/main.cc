@@ -0,0 +1,125 @@
+/*
+ * \brief  Benchmark for pthread mutexes and condition variables
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The 'mutex' workload lets all threads increment a shared counter in a
+ * critical section. With one thread, it measures the uncontended fast path.
+ * The 'condvar' workload passes a token between two threads.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+enum { MAX_THREADS = 16 };
+
+static unsigned long iterations = 100000;
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  cond  = PTHREAD_COND_INITIALIZER;
+
+static unsigned long counter;
+static unsigned      turn;
+
+
+static uint64_t now_us()
+{
+	timespec ts { };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000*1000 + (uint64_t)ts.tv_nsec/1000;
+}
+
+
+static void *mutex_worker(void *)
+{
+	for (unsigned long i = 0; i < iterations; i++) {
+		pthread_mutex_lock(&mutex);
+		counter++;
+		pthread_mutex_unlock(&mutex);
+	}
+	return nullptr;
+}
+
+
+static void *condvar_worker(void *arg)
+{
+	unsigned const id = (unsigned)(uintptr_t)arg;
+
+	for (unsigned long i = 0; i < iterations; i++) {
+		pthread_mutex_lock(&mutex);
+		while (turn != id)
+			pthread_cond_wait(&cond, &mutex);
+		turn = !id;
+		counter++;
+		pthread_cond_signal(&cond);
+		pthread_mutex_unlock(&mutex);
+	}
+	return nullptr;
+}
+
+
+static void run(char const *name, void *(*worker)(void *), unsigned num_threads)
+{
+	pthread_t threads[MAX_THREADS];
+
+	counter = 0;
+	turn    = 0;
+
+	uint64_t const start_us = now_us();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		if (pthread_create(&threads[i], nullptr, worker, (void *)(uintptr_t)i)) {
+			printf("Error: pthread_create failed\n");
+			exit(-1);
+		}
+
+	for (unsigned i = 0; i < num_threads; i++)
+		pthread_join(threads[i], nullptr);
+
+	uint64_t const duration_us = now_us() - start_us;
+
+	if (counter != iterations*num_threads) {
+		printf("Error: counter is %lu, expected %lu\n",
+		       counter, iterations*num_threads);
+		exit(-1);
+	}
+
+	printf("%-7s threads=%-2u %lu operations in %llu us (%llu ns per operation)\n",
+	       name, num_threads, counter, (unsigned long long)duration_us,
+	       (unsigned long long)(duration_us*1000/counter));
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned max_threads = 4;
+
+	if (argc > 1) max_threads = (unsigned)atoi(argv[1]);
+	if (argc > 2) iterations  = (unsigned long)atol(argv[2]);
+
+	if (!max_threads || max_threads > MAX_THREADS || !iterations) {
+		printf("Error: invalid arguments (1...%u threads)\n", (unsigned)MAX_THREADS);
+		return -1;
+	}
+
+	printf("--- mutex contention benchmark started ---\n");
+
+	for (unsigned n = 1; n <= max_threads; n *= 2)
+		run("mutex", mutex_worker, n);
+
+	run("condvar", condvar_worker, 2);
+
+	printf("--- mutex contention benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_mutex_contention
+SRC_CC = main.cc
+LIBS   = posix
@@ -21,6 +21,7 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/uio.h>
 #include <unistd.h>
@@ -97,6 +98,7 @@ static void test(Genode::Xml_node node)
 	char const *file_name3 = "test3.tst";
 	char const *file_name4 = "test4.tst";
 	char const *file_name5 = "test5.tst";
+	char const *file_name6 = "test6.tst";
 	char const *pattern    = "a single line of text";
 
 	size_t const pattern_size = strlen(pattern) + 1;
@@ -216,6 +218,33 @@ static void test(Genode::Xml_node node)
 			printf("file content is correct\n");
 		}
 
+		/* test 'sendfile()' of the whole file and of a range with header */
+		CALL_AND_CHECK(fd, open(file_name, O_RDONLY), fd >= 0, "file_name=%s", file_name);
+		int fd6;
+		CALL_AND_CHECK(fd6, open(file_name6, O_CREAT | O_WRONLY | O_TRUNC), fd6 >= 0, "file_name=%s", file_name6);
+		off_t sbytes = 0;
+		CALL_AND_CHECK(ret, sendfile(fd, fd6, 0, 0, nullptr, &sbytes, 0),
+		               (ret == 0) && ((size_t)sbytes == pattern_size), "");
+		/* send "a " as header followed by the file content from offset 2 */
+		iov[0].iov_base = (void*)pattern;
+		iov[0].iov_len  = 2;
+		struct sf_hdtr hdtr { &iov[0], 1, nullptr, 0 };
+		CALL_AND_CHECK(ret, sendfile(fd, fd6, 2, 0, &hdtr, &sbytes, 0),
+		               (ret == 0) && ((size_t)sbytes == pattern_size), "");
+		CALL_AND_CHECK(ret, (int)lseek(fd, 0, SEEK_CUR), ret == 0, "");
+		CALL_AND_CHECK(ret, close(fd6), ret == 0, "");
+		CALL_AND_CHECK(ret, close(fd), ret == 0, "");
+		CALL_AND_CHECK(fd, open(file_name6, O_RDONLY), fd >= 0, "file_name=%s", file_name6);
+		memset(buf, 0, sizeof(buf));
+		CALL_AND_CHECK(count, read(fd, buf, sizeof(buf)), (size_t)count == 2*pattern_size, "");
+		CALL_AND_CHECK(ret, close(fd), ret == 0, "");
+		if (strcmp(buf, pattern) != 0 || strcmp(&buf[pattern_size], pattern) != 0) {
+			printf("unexpected content of file\n");
+			throw Test_failed();
+		} else {
+			printf("file content is correct\n");
+		}
+
 		/* read directory entries */
 		DIR *dir;
 
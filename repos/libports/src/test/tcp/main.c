@@ -22,6 +22,7 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 /* PCG includes */
@@ -63,6 +64,14 @@ static void check_data()
 }
 
 
+static uint64_t now_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000*1000 + (uint64_t)ts.tv_nsec/1000;
+}
+
+
 int test_send(char const *host)
 {
 	usleep(1000000);
@@ -153,6 +162,8 @@ int test_recv()
 			size_t offset = 0;
 			char *buf = (char *)data;
 
+			uint64_t const start_us = now_us();
+
 			memset(buf, total, 0x55);
 			while (offset < total) {
 				ssize_t res = recv(client, buf+offset, total-offset, 0);
@@ -163,6 +174,12 @@ int test_recv()
 				offset += res;
 			}
 
+			uint64_t const duration_us = now_us() - start_us;
+			if (duration_us)
+				fprintf(stderr, "received %zu KiB in %llu ms (%llu KiB/s)\n",
+				        total/1024, (unsigned long long)duration_us/1000,
+				        (unsigned long long)(total*1000*1000/1024/duration_us));
+
 			check_data();
 		}
 
@@ -0,0 +1,292 @@
+/*
+ * \brief  Packet allocator with a two-level bitmap for packet streams
+ * \author agent
+ * \date   2026-10-19
+ *
+ * In contrast to 'Packet_allocator', which scans the bit array bit by bit,
+ * this allocator keeps a summary bitmap with one bit per word of the block
+ * bitmap that tells whether the word has any free block. Words without free
+ * blocks are thereby skipped with one count-trailing-zeros operation per
+ * summary word and the free runs within a word are determined with a few
+ * word-wide operations. Allocations of a few blocks are thus in O(1) in the
+ * common case, also when the buffer is fragmented. The allocator is a
+ * drop-in replacement for 'Packet_allocator' and can be selected per packet
+ * stream by passing it to the packet-stream source.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__HIERARCHICAL_PACKET_ALLOCATOR_H_
+#define _INCLUDE__OS__HIERARCHICAL_PACKET_ALLOCATOR_H_
+
+#include <base/allocator.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+
+namespace Genode { class Hierarchical_packet_allocator; }
+
+
+class Genode::Hierarchical_packet_allocator : public Genode::Range_allocator
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Hierarchical_packet_allocator(Hierarchical_packet_allocator const &);
+		Hierarchical_packet_allocator &operator = (Hierarchical_packet_allocator const &);
+
+		static constexpr size_t BITS = sizeof(addr_t)*8;
+
+		static constexpr addr_t FULL = ~(addr_t)0;
+
+		Allocator *_md_alloc;               /* meta-data allocator                  */
+		size_t     _block_size;             /* granularity of packet allocations    */
+		addr_t     _base        = 0;        /* allocation base                      */
+		size_t     _num_words   = 0;        /* words of the block bitmap            */
+		size_t     _num_summary = 0;        /* words of the summary bitmap          */
+		addr_t    *_words       = nullptr;  /* bit set if block is allocated        */
+		addr_t    *_summary     = nullptr;  /* bit set if word has a free block     */
+		size_t     _next_word   = 0;        /* word where to start the next search  */
+
+		size_t _md_size() const { return (_num_words + _num_summary)*sizeof(addr_t); }
+
+		size_t _block_cnt(size_t size) const
+		{
+			size_t const cnt = size / _block_size + ((size % _block_size) ? 1 : 0);
+			return cnt ? cnt : 1;
+		}
+
+		void _update_summary(size_t word)
+		{
+			addr_t const bit = (addr_t)1 << (word % BITS);
+			if (_words[word] == FULL)
+				_summary[word / BITS] &= ~bit;
+			else
+				_summary[word / BITS] |= bit;
+		}
+
+		/**
+		 * Return index of first word at or after 'word' with a free block
+		 *
+		 * Returns '_num_words' if there is no such word.
+		 */
+		size_t _next_free_word(size_t word) const
+		{
+			while (word < _num_words) {
+				size_t const idx     = word / BITS;
+				addr_t const pending = _summary[idx] & (FULL << (word % BITS));
+				if (pending)
+					return idx*BITS + (size_t)__builtin_ctzl(pending);
+
+				word = (idx + 1)*BITS;
+			}
+			return _num_words;
+		}
+
+		/**
+		 * Return bitmap of the bits that start 'cnt' consecutive set bits
+		 */
+		static addr_t _run_starts(addr_t bits, size_t cnt)
+		{
+			for (size_t len = 1; len < cnt && bits; ) {
+				size_t const shift = min(len, cnt - len);
+				bits &= bits >> shift;
+				len  += shift;
+			}
+			return bits;
+		}
+
+		/**
+		 * Return whether 'cnt' blocks starting at the first block of 'word'
+		 * are free
+		 */
+		bool _free_from_word(size_t word, size_t cnt) const
+		{
+			for (; cnt >= BITS; cnt -= BITS, word++)
+				if (word >= _num_words || _words[word])
+					return false;
+
+			if (!cnt)
+				return true;
+
+			if (word >= _num_words)
+				return false;
+
+			return !(_words[word] & (((addr_t)1 << cnt) - 1));
+		}
+
+		/**
+		 * Find 'cnt' free blocks that start in the words [first, end)
+		 */
+		bool _find(size_t cnt, size_t first, size_t end, size_t &block) const
+		{
+			for (size_t word = _next_free_word(first); word < end;
+			     word = _next_free_word(word + 1))
+			{
+				addr_t const free = ~_words[word];
+
+				/* run within the word */
+				if (cnt <= BITS) {
+					addr_t const starts = _run_starts(free, cnt);
+					if (starts) {
+						block = word*BITS + (size_t)__builtin_ctzl(starts);
+						return true;
+					}
+				}
+				/* run that starts with the free top blocks of the word */
+				size_t const top = (free == FULL) ? BITS : (size_t)__builtin_clzl(~free);
+				if (top && top < cnt && _free_from_word(word + 1, cnt - top)) {
+					block = word*BITS + BITS - top;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void _mark(size_t block, size_t cnt, bool allocated)
+		{
+			while (cnt) {
+				size_t const word  = block / BITS;
+				size_t const shift = block % BITS;
+				size_t const num   = min(cnt, BITS - shift);
+				addr_t const mask  = ((num == BITS) ? FULL
+				                                    : (((addr_t)1 << num) - 1)) << shift;
+				if (allocated)
+					_words[word] |= mask;
+				else
+					_words[word] &= ~mask;
+
+				_update_summary(word);
+				block += num;
+				cnt   -= num;
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param md_alloc       Meta-data allocator
+		 * \param block_size     Granularity of packets in stream
+		 */
+		Hierarchical_packet_allocator(Allocator *md_alloc, size_t block_size)
+		: _md_alloc(md_alloc), _block_size(block_size) { }
+
+		~Hierarchical_packet_allocator()
+		{
+			if (_words)
+				_md_alloc->free(_words, _md_size());
+		}
+
+
+		/*******************************
+		 ** Range-allocator interface **
+		 *******************************/
+
+		Range_result add_range(addr_t const base, size_t const size) override
+		{
+			if (_base || _words)
+				return Alloc_error::DENIED;
+
+			size_t const num_blocks = size / _block_size;
+			if (!num_blocks)
+				return Alloc_error::DENIED;
+
+			_num_words   = (num_blocks + BITS - 1) / BITS;
+			_num_summary = (_num_words + BITS - 1) / BITS;
+
+			return _md_alloc->try_alloc(_md_size()).convert<Range_result>(
+
+				[&] (Allocation &a) -> Range_result {
+					a.deallocate = false;
+					_base    = base;
+					_words   = (addr_t *)a.ptr;
+					_summary = _words + _num_words;
+					memset(_words, 0, _md_size());
+
+					/* reserve blocks which are unavailable */
+					size_t const last_bits = num_blocks % BITS;
+					if (last_bits)
+						_words[_num_words - 1] = FULL << last_bits;
+
+					for (size_t word = 0; word < _num_words; word++)
+						_update_summary(word);
+
+					return Ok();
+				},
+				[&] (Alloc_error e) -> Range_result {
+					_num_words = _num_summary = 0;
+					return e;
+				});
+		}
+
+		Range_result remove_range(addr_t base, size_t) override
+		{
+			if (_base != base)
+				return Alloc_error::DENIED;
+
+			if (_words)
+				_md_alloc->free(_words, _md_size());
+
+			_base      = 0;
+			_next_word = 0;
+			_words     = nullptr;
+			_summary   = nullptr;
+			_num_words = _num_summary = 0;
+			return Ok();
+		}
+
+		Alloc_result alloc_aligned(size_t size, unsigned, Range) override
+		{
+			return try_alloc(size);
+		}
+
+		Alloc_result try_alloc(size_t size) override
+		{
+			if (!_words)
+				return Alloc_error::DENIED;
+
+			size_t const cnt = _block_cnt(size);
+			size_t block = 0;
+			if (!_find(cnt, _next_word, _num_words, block) &&
+			    !_find(cnt, 0, _next_word, block))
+				return Alloc_error::DENIED;
+
+			_mark(block, cnt, true);
+			_next_word = (block + cnt) / BITS;
+			return { *this, {
+				.ptr       = reinterpret_cast<void *>(block*_block_size + _base),
+				.num_bytes = size } };
+		}
+
+		void _free(Allocation &a) override { free(a.ptr, a.num_bytes); }
+
+		void free(void *addr, size_t size) override
+		{
+			size_t const block = (((addr_t)addr) - _base) / _block_size;
+			_mark(block, _block_cnt(size), false);
+			_next_word = block / BITS;
+		}
+
+
+		/*************
+		 ** Dummies **
+		 *************/
+
+		bool need_size_for_free() const override { return true; }
+		void free(void *) override { }
+		size_t overhead(size_t) const override {  return 0;}
+		size_t avail() const override { return 0; }
+		bool valid_addr(addr_t) const override { return 0; }
+		Alloc_result alloc_addr(size_t, addr_t) override {
+			return Alloc_error::DENIED; }
+};
+
+#endif /* _INCLUDE__OS__HIERARCHICAL_PACKET_ALLOCATOR_H_ */
@@ -48,7 +48,7 @@ class Trace_buffer
 			if (lost) {
 				warning("lost ", _buffer.lost_entries() - _lost_count,
 				        ", entries; you might want to raise buffer size");
-				_lost_count = (unsigned)_buffer.lost_entries();
+				_lost_count = _buffer.lost_entries();
 			}
 
 			Entry entry { _curr };
@@ -81,6 +81,11 @@ class Trace_buffer
 
 		void * address() const { return &_buffer; }
 
+		/**
+		 * Return number of entries lost due to buffer overruns so far
+		 */
+		unsigned long long lost_entries() const { return _lost_count; }
+
 		bool empty() const { return !_buffer.initialized() || _curr.head(); }
 };
 
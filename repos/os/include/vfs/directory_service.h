@@ -30,6 +30,14 @@ struct Vfs::Directory_service : Interface
 	virtual Dataspace_capability dataspace(char const *path) = 0;
 	virtual void release(char const *path, Dataspace_capability) = 0;
 
+	/**
+	 * Return true if 'dataspace' hands out the file content without copying
+	 *
+	 * This allows the caller to prefer reading a small part of a large
+	 * file over obtaining a copy of the whole file as dataspace.
+	 */
+	virtual bool dataspace_without_copy(char const *) { return false; }
+
 
 	enum General_error { ERR_FD_INVALID, NUM_GENERAL_ERRORS };
 
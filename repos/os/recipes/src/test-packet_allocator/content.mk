@@ -0,0 +1,2 @@
+SRC_DIR = src/test/packet_allocator
+include $(GENODE_DIR)/repos/base/recipes/src/content.inc
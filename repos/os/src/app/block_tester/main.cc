@@ -88,8 +88,11 @@ struct Test::Result
 	Total    tx;
 	size_t   request_size;
 	size_t   block_size;
+	size_t   batch;
 	size_t   triggered;
 
+	struct Latency { uint64_t avg, p50, p99, p999, max; } latency;
+
 	double mibs() const
 	{
 		if (!duration)
@@ -119,6 +122,12 @@ struct Test::Result
 		           "mibs:",      mibs(),    " "
 		           "iops:",      iops(),    " "
 		           "duration:",  duration,  " "
+		           "batch:",     batch,     " "
+		           "lat_avg:",   latency.avg,  "us "
+		           "lat_p50:",   latency.p50,  "us "
+		           "lat_p99:",   latency.p99,  "us "
+		           "lat_p999:",  latency.p999, "us "
+		           "lat_max:",   latency.max,  "us "
 		           "triggered:", triggered, " "
 		           "result:",    success ? "ok" : "failed");
 	}
@@ -128,10 +137,12 @@ struct Test::Result
 struct Test::Test_job : Block::Connection<Test_job>::Job
 {
 	unsigned const id;
+	uint64_t const start_us;
 
-	Test_job(Block::Connection<Test_job> &conn, Block::Operation op, unsigned id)
+	Test_job(Block::Connection<Test_job> &conn, Block::Operation op, unsigned id,
+	         uint64_t start_us)
 	:
-		Block::Connection<Test_job>::Job(conn, op), id(id)
+		Block::Connection<Test_job>::Job(conn, op), id(id), start_us(start_us)
 	{ }
 };
 
@@ -148,8 +159,12 @@ struct Test::Block_connection : Block::Connection<Test_job>
 
 	Allocator &_alloc;
 
+	Timer::Connection &_timer;
+
 	Stats stats { };
 
+	uint64_t now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
 	struct Action : Genode::Interface
 	{
 		virtual void spawn_jobs(Stats &) = 0;
@@ -161,11 +176,11 @@ struct Test::Block_connection : Block::Connection<Test_job>
 
 	Scratch_buffer &_scratch_buffer;
 
-	Block_connection(Config config, Attr attr, Allocator &alloc, Action &action,
-	                 Scratch_buffer &scratch_buffer, auto &&... args)
+	Block_connection(Config config, Attr attr, Allocator &alloc, Timer::Connection &timer,
+	                 Action &action, Scratch_buffer &scratch_buffer, auto &&... args)
 	:
 		Block::Connection<Test_job>(args...),
-		_config(config), _attr(attr), _alloc(alloc), _action(action),
+		_config(config), _attr(attr), _alloc(alloc), _timer(timer), _action(action),
 		_scratch_buffer(scratch_buffer)
 	{ }
 
@@ -216,6 +231,7 @@ struct Test::Block_connection : Block::Connection<Test_job>
 	void completed(Test_job &job, bool success)
 	{
 		stats.completed++;
+		stats.latency.add(now_us() - job.start_us);
 
 		if (_attr.verbose)
 			log("job ", job.id, ": ", job.operation(), ", completed");
@@ -319,7 +335,8 @@ struct Test::Test
 							[&] (Block::Operation operation) {
 								stats.job_cnt++;
 								new (_test._alloc)
-									Test_job(_test._block, operation, stats.job_cnt);
+									Test_job(_test._block, operation, stats.job_cnt,
+									         _test._block.now_us());
 								return true;
 							},
 							[&] (Scenario::No_job) {
@@ -353,7 +370,7 @@ struct Test::Test
 			_env(env), _alloc(alloc), _scenario(scenario),
 			_block(config, { .copy    = _scenario.attr.copy,
 			                 .verbose = _scenario.attr.verbose },
-			       _alloc, _block_action, scratch_buffer,
+			       _alloc, _timer, _block_action, scratch_buffer,
 			       _env, &_block_alloc, _scenario.attr.io_buffer),
 			_finished_sig(finished_sig),
 			_scratch_buffer(scratch_buffer)
@@ -384,6 +401,8 @@ struct Test::Test
 
 		Result result()
 		{
+			Latency_histogram const &latency = _block.stats.latency;
+
 			return {
 				.success      = _success,
 				.duration     = _end_time - _start_time,
@@ -392,7 +411,13 @@ struct Test::Test
 				.tx           = _block.stats.tx,
 				.request_size = _scenario.request_size(),
 				.block_size   = _block.block_size,
-				.triggered    = _triggered
+				.batch        = _scenario.attr.batch,
+				.triggered    = _triggered,
+				.latency      = { .avg  = latency.avg_us(),
+				                  .p50  = latency.percentile(50,  100),
+				                  .p99  = latency.percentile(99,  100),
+				                  .p999 = latency.percentile(999, 1000),
+				                  .max  = latency.max_us }
 			};
 		}
 };
@@ -435,11 +460,18 @@ struct Test::Main
 					xml.attribute("bytes",    tr.result.total.bytes);
 					xml.attribute("size",     tr.result.request_size);
 					xml.attribute("bsize",    tr.result.block_size);
+					xml.attribute("batch",    tr.result.batch);
 					xml.attribute("duration", tr.result.duration);
 
 					xml.attribute("mibs", (unsigned)(tr.result.mibs() * (1<<20u)));
 					xml.attribute("iops", (unsigned)(tr.result.iops() + 0.5f));
 
+					xml.attribute("lat_avg",  tr.result.latency.avg);
+					xml.attribute("lat_p50",  tr.result.latency.p50);
+					xml.attribute("lat_p99",  tr.result.latency.p99);
+					xml.attribute("lat_p999", tr.result.latency.p999);
+					xml.attribute("lat_max",  tr.result.latency.max);
+
 					xml.attribute("result", tr.result.success ? 0 : 1);
 				});
 			});
@@ -505,6 +537,94 @@ struct Test::Main
 
 	Scratch_buffer _scratch_buffer { _heap, _config.scratch_buffer_size };
 
+	/*
+	 * List of values of a sweep attribute, e.g., batch="1 4 16 64"
+	 *
+	 * If the attribute is absent, the list contains the single value 0,
+	 * which keeps the attribute of the swept test node as is.
+	 */
+	struct Sweep_values
+	{
+		enum { MAX = 16 };
+
+		size_t   values[MAX] { };
+		unsigned count       { 0 };
+
+		Sweep_values(Xml_node const &sweep, char const *attr)
+		{
+			String<160> const list = sweep.attribute_value(attr, String<160>());
+
+			for (char const *s = list.string(); *s && count < MAX; ) {
+				if (*s == ' ' || *s == ',') { s++; continue; }
+
+				Number_of_bytes value { };
+				size_t const len = ascii_to(s, value);
+				if (!len) {
+					warning("sweep: invalid ", attr, " value list '", list, "'");
+					break;
+				}
+				values[count++] = value;
+				s += len;
+			}
+			if (!count)
+				values[count++] = 0;
+		}
+
+		void for_each(auto const &fn) const
+		{
+			for (unsigned i = 0; i < count; i++)
+				fn(values[i]);
+		}
+	};
+
+	/*
+	 * Expand each test node of a '<sweep>' node into one scenario per
+	 * combination of the swept 'batch' and 'size' values
+	 */
+	void _construct_sweep(Xml_node const &sweep, auto const &create)
+	{
+		Sweep_values const batches { sweep, "batch" };
+		Sweep_values const sizes   { sweep, "size" };
+
+		auto generate = [&] (Xml_generator &xml, Xml_node const &test,
+		                     size_t batch, size_t size)
+		{
+			test.for_each_attribute([&] (Xml_attribute const &attr) {
+				if ((batch && attr.has_type("batch")) || (size && attr.has_type("size")))
+					return;
+
+				attr.with_raw_value([&] (char const *start, size_t len) {
+					xml.attribute(attr.name().string(), String<160>(Cstring(start, len))); });
+			});
+			if (batch) xml.attribute("batch", batch);
+			if (size)  xml.attribute("size",  size);
+
+			test.with_raw_content([&] (char const *start, size_t len) {
+				xml.append(start, len); });
+		};
+
+		sweep.for_each_sub_node([&] (Xml_node const &test) {
+
+			size_t const buffer_size = test.size() + 128;
+			char * const buffer      = (char *)_heap.alloc(buffer_size);
+
+			batches.for_each([&] (size_t batch) {
+				sizes.for_each([&] (size_t size) {
+					Xml_generator::generate({ buffer, buffer_size }, test.type(),
+						[&] (Xml_generator &xml) { generate(xml, test, batch, size); }
+					).with_result(
+						[&] (size_t) {
+							Scenario *ptr = create(Xml_node(buffer, buffer_size));
+							if (ptr)
+								_scenarios.enqueue(*ptr); },
+						[&] (Buffer_error) {
+							error("sweep: failed to generate ", test.type(), " node"); });
+				});
+			});
+			_heap.free(buffer, buffer_size);
+		});
+	}
+
 	void _construct_scenarios(Xml_node const &config)
 	{
 		auto create = [&] (Xml_node const &node) -> Scenario *
@@ -520,6 +640,10 @@ struct Test::Main
 			config.with_sub_node("tests",
 				[&] (Xml_node const &tests) {
 					tests.for_each_sub_node([&] (Xml_node const &node) {
+						if (node.has_type("sweep")) {
+							_construct_sweep(node, create);
+							return;
+						}
 						Scenario *ptr = create(node);
 						if (ptr)
 							_scenarios.enqueue(*ptr); });
@@ -67,6 +67,109 @@ namespace Util {
 
 			return result;
 		}
+
+		/**
+		 * Return uniformly distributed value in [0, 1)
+		 */
+		double get_double() { return (double)(get() >> 11) * 0x1p-53; }
+	};
+
+	/*
+	 * Natural logarithm and exponential function as there is no libm
+	 */
+
+	static inline double ln(double x)
+	{
+		if (x <= 0)
+			return -1e300;
+
+		/* x = m * 2^e with m in [1, 2), ln(m) = 2 atanh((m - 1)/(m + 1)) */
+		int e = 0;
+		for (; x >= 2.0; x /= 2) e++;
+		for (; x <  1.0; x *= 2) e--;
+
+		double const t = (x - 1)/(x + 1), t2 = t*t;
+		double sum = 0, term = t;
+		for (unsigned k = 1; k < 40; k += 2, term *= t2)
+			sum += term/k;
+
+		return 2*sum + e*0.69314718055994531;
+	}
+
+	static inline double exp(double x)
+	{
+		if (x < -700) return 0;
+		if (x >  700) return 1e300;
+
+		/* x = k ln(2) + r with |r| <= ln(2)/2 */
+		int    const k = (int)(x/0.69314718055994531 + (x < 0 ? -0.5 : 0.5));
+		double const r = x - k*0.69314718055994531;
+
+		double sum = 1, term = 1;
+		for (unsigned n = 1; n < 20; n++) {
+			term *= r/n;
+			sum  += term;
+		}
+		for (int i = 0; i < k; i++) sum *= 2;
+		for (int i = 0; i > k; i--) sum /= 2;
+		return sum;
+	}
+
+	/*
+	 * Zipf-distributed ranks in [1, n] with exponent 'theta'
+	 *
+	 * Rejection-inversion sampling after W. Hörmann and G. Derflinger,
+	 * "Rejection-inversion to generate variates from monotone discrete
+	 * distributions", which needs constant time and space per sample.
+	 */
+	struct Zipf
+	{
+		uint64_t const _n;
+		double   const _theta;
+
+		/* (exp(x) - 1)/x and ln(1 + x)/x, stable for small x */
+		static double _expm1_div(double x) {
+			return (x > 1e-8 || x < -1e-8) ? (exp(x) - 1)/x : 1 + x/2*(1 + x/3*(1 + x/4)); }
+
+		static double _log1p_div(double x) {
+			return (x > 1e-8 || x < -1e-8) ? ln(1 + x)/x : 1 - x*(0.5 - x*(1.0/3 - x/4)); }
+
+		double _h(double x) const { return exp(-_theta*ln(x)); }
+
+		double _h_integral(double x) const
+		{
+			double const log_x = ln(x);
+			return _expm1_div((1 - _theta)*log_x)*log_x;
+		}
+
+		double _h_integral_inverse(double x) const
+		{
+			double t = x*(1 - _theta);
+			if (t < -1) t = -1;
+			return exp(_log1p_div(t)*x);
+		}
+
+		double const _h_integral_x1 = _h_integral(1.5) - 1;
+		double const _h_integral_n  = _h_integral((double)_n + 0.5);
+		double const _s = 2 - _h_integral_inverse(_h_integral(2.5) - _h(2));
+
+		Zipf(uint64_t n, double theta) : _n(n), _theta(theta) { }
+
+		uint64_t get(Xoroshiro &random) const
+		{
+			for (;;) {
+				double const u = _h_integral_n
+				               + random.get_double()*(_h_integral_x1 - _h_integral_n);
+				double const x = _h_integral_inverse(u);
+
+				uint64_t k = (uint64_t)(x + 0.5);
+				if (k < 1)  k = 1;
+				if (k > _n) k = _n;
+
+				if ((double)k - x <= _s || u >= _h_integral((double)k + 0.5) - _h((double)k))
+					return k;
+			}
+		}
 	};
 }
 
@@ -76,7 +179,8 @@ namespace Util {
  *
  * This test reads or writes the given number of bytes in
  * sized requests in a deterministic order that depends on
- * the seed value of a PRNG.
+ * the seed value of a PRNG. Offsets are either uniformly or
+ * Zipf distributed.
  */
 struct Test::Random : Scenario
 {
@@ -88,6 +192,15 @@ struct Test::Random : Scenario
 	bool     const _w;
 	bool     const _alternate_access = _r && _w;
 
+	/* share of writes in percent, overrides 'read' and 'write' if set */
+	unsigned const _write_percent;
+	bool     const _mixed_access = _write_percent <= 100;
+
+	/* exponent of the Zipf distribution, 0 for uniformly distributed offsets */
+	double   const _zipf_theta;
+
+	Constructible<Util::Zipf> _zipf { };
+
 	Block::Operation::Type const _op_type = _w ? Block::Operation::Type::WRITE
 	                                           : Block::Operation::Type::READ;
 
@@ -96,6 +209,14 @@ struct Test::Random : Scenario
 
 	block_number_t _next_block()
 	{
+		if (_zipf.constructed()) {
+
+			/* scatter the popular ranks over the whole device */
+			uint64_t const slots = _block_count.blocks / _op_size.blocks;
+			uint64_t const rank  = _zipf->get(_random) - 1;
+			return ((rank * 0x9E3779B97F4A7C15ULL) % slots) * _op_size.blocks;
+		}
+
 		uint64_t r = 0;
 		block_number_t max = _block_count.blocks;
 		if (max >= _op_size.blocks + 1)
@@ -114,7 +235,9 @@ struct Test::Random : Scenario
 		_size  (node.attribute_value("size",   Number_of_bytes())),
 		_length(node.attribute_value("length", Number_of_bytes())),
 		_r     (node.attribute_value("read",   false)),
-		_w     (node.attribute_value("write",  false))
+		_w     (node.attribute_value("write",  false)),
+		_write_percent(node.attribute_value("write_percent", ~0u)),
+		_zipf_theta   (node.attribute_value("zipf", 0.0))
 	{ }
 
 	bool init(Init_attr const &attr) override
@@ -134,8 +257,27 @@ struct Test::Random : Scenario
 			return false;
 		}
 
+		if (_write_percent != ~0u && !_mixed_access) {
+			error("write_percent exceeds 100");
+			return false;
+		}
+
+		if (_zipf_theta < 0) {
+			error("zipf exponent must be positive");
+			return false;
+		}
+
 		_block_count = { attr.block_count };
 		_op_size     = { _size / attr.block_size };
+
+		if (_block_count.blocks < _op_size.blocks) {
+			error("request size exceeds block device");
+			return false;
+		}
+
+		if (_zipf_theta > 0)
+			_zipf.construct(_block_count.blocks / _op_size.blocks, _zipf_theta);
+
 		return true;
 	}
 
@@ -146,7 +288,12 @@ struct Test::Random : Scenario
 
 		block_number_t const lba = _next_block();
 
+		auto mixed_type = [&] {
+			return (_random.get() % 100 < _write_percent) ? Block::Operation::Type::WRITE
+			                                              : Block::Operation::Type::READ; };
+
 		Block::Operation::Type const op_type =
+			_mixed_access     ? mixed_type() :
 			_alternate_access ? (lba & 0x1) ? Block::Operation::Type::WRITE
 			                                : Block::Operation::Type::READ
 			                  : _op_type;
@@ -165,6 +312,12 @@ struct Test::Random : Scenario
 		Genode::print(out, name(), " "
 		                   "size:",   Number_of_bytes(_size),   " "
 		                   "length:", Total(_length), " ");
+
+		if (_mixed_access)
+			Genode::print(out, "write_percent:", _write_percent, " ");
+
+		if (_zipf_theta > 0)
+			Genode::print(out, "zipf:", _zipf_theta, " ");
 	}
 };
 
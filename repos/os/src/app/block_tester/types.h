@@ -35,18 +35,89 @@ namespace Test {
 		void print(Output &out) const { Number_of_bytes::print(out, bytes); }
 	};
 
-	struct Stats
-	{
-		Total rx, tx;
-		Total total;
-		unsigned completed;
-		unsigned job_cnt;
-	};
+	struct Latency_histogram;
+
+	struct Stats;
 
 	struct Scenario;
 }
 
 
+/*
+ * Log-linear histogram of request latencies in microseconds
+ *
+ * Each power-of-two range is split into 'SUB_BUCKETS' linear buckets, which
+ * bounds the error of the reported percentiles to 1/SUB_BUCKETS.
+ */
+struct Test::Latency_histogram
+{
+	static constexpr unsigned SUB_BITS    = 4;
+	static constexpr unsigned SUB_BUCKETS = 1u << SUB_BITS;
+	static constexpr unsigned NUM_BUCKETS = (64 - SUB_BITS + 1)*SUB_BUCKETS;
+
+	uint64_t buckets[NUM_BUCKETS];
+	uint64_t count;
+	uint64_t sum_us;
+	uint64_t max_us;
+
+	static unsigned _bucket(uint64_t us)
+	{
+		if (us < SUB_BUCKETS)
+			return (unsigned)us;
+
+		unsigned const shift = (unsigned)log2(us) - SUB_BITS;
+		return (shift + 1)*SUB_BUCKETS + (unsigned)((us >> shift) - SUB_BUCKETS);
+	}
+
+	/**
+	 * Return largest latency that falls into the bucket
+	 */
+	static uint64_t _bucket_limit(unsigned bucket)
+	{
+		if (bucket < SUB_BUCKETS)
+			return bucket;
+
+		unsigned const shift = bucket/SUB_BUCKETS - 1;
+		return (((uint64_t)(bucket % SUB_BUCKETS) + SUB_BUCKETS + 1) << shift) - 1;
+	}
+
+	void add(uint64_t us)
+	{
+		buckets[_bucket(us)]++;
+		count++;
+		sum_us += us;
+		max_us  = max(max_us, us);
+	}
+
+	/**
+	 * Return latency below which the fraction 'num/denom' of requests lies
+	 */
+	uint64_t percentile(uint64_t num, uint64_t denom) const
+	{
+		uint64_t const target = (count*num + denom - 1)/denom;
+		uint64_t sum = 0;
+		for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+			sum += buckets[i];
+			if (sum && sum >= target)
+				return min(_bucket_limit(i), max_us);
+		}
+		return max_us;
+	}
+
+	uint64_t avg_us() const { return count ? sum_us/count : 0; }
+};
+
+
+struct Test::Stats
+{
+	Total rx, tx;
+	Total total;
+	unsigned completed;
+	unsigned job_cnt;
+	Latency_histogram latency;
+};
+
+
 struct Test::Scenario : Interface, private Fifo<Scenario>::Element
 {
 	friend class Fifo<Scenario>;
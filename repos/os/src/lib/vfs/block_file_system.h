@@ -31,12 +31,623 @@ struct Vfs::Block_file_system
 {
 	using Name = String<64>;
 
+	class Io;
+	class Cache;
 	struct Local_factory;
 	struct Data_file_system;
 	struct Compound_file_system;
 };
 
 
+/**
+ * Block requests that are kept in flight concurrently
+ *
+ * Each request is tagged with the index of its job slot. The data of
+ * completed requests is passed to the 'Completion' of the job before the
+ * packet is released, so callers never wait for one request before issuing
+ * the next one.
+ */
+class Vfs::Block_file_system::Io
+{
+	public:
+
+		using Opcode = Block::Packet_descriptor::Opcode;
+
+		struct Completion : Genode::Interface
+		{
+			/**
+			 * Called on acknowledgement of a request
+			 *
+			 * \param content  payload of the packet, only valid during call
+			 */
+			virtual void io_completed(Block::Packet_descriptor const &packet,
+			                          char const *content) = 0;
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Io(Io const &);
+		Io &operator = (Io const &);
+
+		enum { MAX_JOBS = 64 };
+
+		Genode::Entrypoint         &_ep;
+		Block::Session::Info const &_info;
+		Block::Session::Tx::Source &_tx_source;
+		Completion                 *_jobs[MAX_JOBS] { };
+		unsigned                    _in_flight { 0 };
+
+		bool _alloc_job(unsigned &idx) const
+		{
+			for (idx = 0; idx < MAX_JOBS; idx++)
+				if (!_jobs[idx])
+					return true;
+			return false;
+		}
+
+	public:
+
+		Io(Genode::Entrypoint &ep, Block::Connection<> &block,
+		   Block::Session::Info const &info)
+		:
+			_ep(ep), _info(info), _tx_source(*block.tx())
+		{ }
+
+		/**
+		 * Handle acknowledgements that are available without blocking
+		 */
+		void process_acks()
+		{
+			while (_tx_source.ack_avail()) {
+
+				Block::Packet_descriptor const packet = _tx_source.get_acked_packet();
+				unsigned long const idx = packet.tag().value;
+				if (idx >= MAX_JOBS || !_jobs[idx]) {
+					Genode::error("vfs_block: unexpected block acknowledgement");
+					_tx_source.release_packet(packet);
+					continue;
+				}
+				Completion &completion = *_jobs[idx];
+				_jobs[idx] = nullptr;
+				_in_flight--;
+
+				completion.io_completed(packet, packet.size()
+					? _tx_source.packet_content(packet) : nullptr);
+
+				_tx_source.release_packet(packet);
+			}
+		}
+
+		/**
+		 * Submit request without waiting for its completion
+		 *
+		 * \param fill  called with the packet content of a write request
+		 *
+		 * \return false if the request cannot be submitted at the moment
+		 *         because of exhausted job slots, packet-buffer space, or
+		 *         submit-queue capacity
+		 */
+		bool try_submit(Opcode op, Block::block_number_t nr,
+		                Block::block_count_t cnt, Completion &completion,
+		                auto const &fill)
+		{
+			unsigned idx = 0;
+			if (!_alloc_job(idx) || !_tx_source.ready_to_submit())
+				return false;
+
+			size_t const size = (op == Block::Packet_descriptor::READ ||
+			                     op == Block::Packet_descriptor::WRITE)
+			                  ? (size_t)cnt*_info.block_size : 0;
+
+			return _tx_source.alloc_packet_attempt(size, (unsigned)_info.align_log2).convert<bool>(
+				[&] (Block::Packet_descriptor const &alloc) {
+
+					Block::Packet_descriptor const packet(alloc, op, nr, cnt,
+					                                      Block::Session::Tag { idx });
+					if (op == Block::Packet_descriptor::WRITE)
+						fill(_tx_source.packet_content(packet));
+
+					_jobs[idx] = &completion;
+					_in_flight++;
+					_tx_source.try_submit_packet(packet);
+					return true;
+				},
+				[&] (Block::Session::Tx::Source::Alloc_packet_error) { return false; });
+		}
+
+		/**
+		 * Block until at least one request got acknowledged
+		 */
+		void wait_for_ack()
+		{
+			_tx_source.wakeup();
+			while (!_tx_source.ack_avail())
+				_ep.wait_and_dispatch_one_io_signal();
+
+			process_acks();
+		}
+
+		/**
+		 * Notify the server about requests submitted without waiting
+		 */
+		void wakeup() { _tx_source.wakeup(); }
+
+		void wait_until_idle()
+		{
+			while (_in_flight)
+				wait_for_ack();
+		}
+
+		bool in_flight() const { return _in_flight > 0; }
+};
+
+
+/**
+ * LRU block cache with write-back and sequential read-ahead
+ *
+ * The cache consists of lines of consecutive blocks. Writes modify cached
+ * lines only and are written back to the device when a dirty line gets
+ * evicted or on 'flush'. Adjacent dirty lines are written back with a single
+ * request. Reading line N directly after line N-1 triggers the asynchronous
+ * load of the next 'read_ahead' lines.
+ */
+class Vfs::Block_file_system::Cache : private Io::Completion
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Cache(Cache const &);
+		Cache &operator = (Cache const &);
+
+		using block_number_t = Block::block_number_t;
+		using block_count_t  = Block::block_count_t;
+
+		enum { LINE_SIZE = 16*1024 };
+
+		struct Line
+		{
+			enum State { EMPTY, LOADING, VALID };
+
+			Genode::uint64_t nr        { 0 };
+			State            state     { EMPTY };
+			bool             dirty     { false };
+			unsigned         writing   { 0 };
+			bool             hashed    { false };
+			char            *data      { nullptr };
+			Line            *lru_prev  { nullptr };
+			Line            *lru_next  { nullptr };
+			Line            *hash_next { nullptr };
+
+			bool idle() const { return state != LOADING && !dirty && !writing; }
+		};
+
+		Genode::Allocator &_alloc;
+		Io                &_io;
+		size_t      const  _block_size;
+		block_number_t const _block_count;
+		block_count_t const _line_blocks;
+		size_t      const  _line_size;
+		unsigned    const  _num_lines;
+		unsigned    const  _read_ahead;
+		block_count_t const _max_request_blocks;
+		Line              *_lines;
+		Line             **_buckets;
+		char              *_data;
+		Line              *_lru_head   { nullptr };
+		Line              *_lru_tail   { nullptr };
+		Genode::uint64_t   _last_read  { ~0ULL };
+		bool               _io_error   { false };
+		unsigned           _write_errors { 0 };
+
+		Genode::uint64_t _num_line_nrs() const {
+			return (_block_count + _line_blocks - 1) / _line_blocks; }
+
+		block_count_t _blocks_of(Line const &line) const
+		{
+			block_number_t const first = line.nr*_line_blocks;
+			return (block_count_t)Genode::min((block_number_t)_line_blocks,
+			                                  _block_count - first);
+		}
+
+		Line *&_bucket(Genode::uint64_t nr) { return _buckets[nr % _num_lines]; }
+
+		Line *_lookup(Genode::uint64_t nr)
+		{
+			for (Line *line = _bucket(nr); line; line = line->hash_next)
+				if (line->nr == nr)
+					return line;
+			return nullptr;
+		}
+
+		void _hash(Line &line, Genode::uint64_t nr)
+		{
+			line.nr        = nr;
+			line.state     = Line::EMPTY;
+			line.hash_next = _bucket(nr);
+			line.hashed    = true;
+			_bucket(nr)    = &line;
+		}
+
+		void _unhash(Line &line)
+		{
+			if (!line.hashed)
+				return;
+
+			for (Line **elem = &_bucket(line.nr); *elem; elem = &(*elem)->hash_next)
+				if (*elem == &line) {
+					*elem = line.hash_next;
+					break;
+				}
+			line.hash_next = nullptr;
+			line.hashed    = false;
+			line.state     = Line::EMPTY;
+		}
+
+		void _lru_remove(Line &line)
+		{
+			if (line.lru_prev) line.lru_prev->lru_next = line.lru_next;
+			else               _lru_head = line.lru_next;
+			if (line.lru_next) line.lru_next->lru_prev = line.lru_prev;
+			else               _lru_tail = line.lru_prev;
+			line.lru_prev = line.lru_next = nullptr;
+		}
+
+		void _lru_touch(Line &line)
+		{
+			_lru_remove(line);
+			line.lru_next = _lru_head;
+			if (_lru_head) _lru_head->lru_prev = &line;
+			_lru_head = &line;
+			if (!_lru_tail) _lru_tail = &line;
+		}
+
+		/**
+		 * Write back a dirty line together with its dirty successors
+		 */
+		bool _try_write_back(Line &first)
+		{
+			if (first.writing)
+				return false;
+
+			/* gather run of adjacent dirty lines */
+			Line *run[32] { };
+			unsigned cnt = 0;
+			block_count_t blocks = 0;
+			for (Line *line = &first; line && cnt < 32; line = _lookup(line->nr + 1)) {
+				if (!line->dirty || line->writing || line->state != Line::VALID)
+					break;
+				if (cnt && blocks + _blocks_of(*line) > _max_request_blocks)
+					break;
+				run[cnt++] = line;
+				blocks    += _blocks_of(*line);
+				if (_blocks_of(*line) != _line_blocks)
+					break;
+			}
+			if (!cnt)
+				return false;
+
+			bool const submitted = _io.try_submit(Block::Packet_descriptor::WRITE,
+			                                      first.nr*_line_blocks, blocks, *this,
+				[&] (char *content) {
+					for (unsigned i = 0; i < cnt; i++)
+						Genode::memcpy(content + i*_line_size, run[i]->data,
+						               _blocks_of(*run[i])*_block_size); });
+			if (!submitted)
+				return false;
+
+			for (unsigned i = 0; i < cnt; i++) {
+				run[i]->dirty = false;
+				run[i]->writing++;
+			}
+			return true;
+		}
+
+		bool _try_load(Line &line)
+		{
+			if (!_io.try_submit(Block::Packet_descriptor::READ,
+			                    line.nr*_line_blocks, _blocks_of(line), *this,
+			                    [] (char *) { }))
+				return false;
+
+			line.state = Line::LOADING;
+			return true;
+		}
+
+		/**
+		 * Find an idle line for reuse, starting write-backs on the way
+		 *
+		 * \param wait     whether to wait for in-flight requests if no line
+		 *                 is idle, otherwise return nullptr
+		 * \param exclude  line that must not be reused
+		 */
+		Line *_victim(bool wait, Line const *exclude = nullptr)
+		{
+			unsigned const write_errors = _write_errors;
+
+			for (;;) {
+				for (Line *line = _lru_tail; line; line = line->lru_prev) {
+					if (line->idle() && line != exclude)
+						return line;
+					if (wait && line->dirty)
+						_try_write_back(*line);
+				}
+
+				/* give up instead of retrying write-backs the device refuses */
+				if (!wait || !_io.in_flight() || _write_errors != write_errors)
+					return nullptr;
+
+				_io.wait_for_ack();
+			}
+		}
+
+		Line *_acquire(Genode::uint64_t nr)
+		{
+			Line *line = _lookup(nr);
+			if (!line) {
+				line = _victim(true);
+				if (!line)
+					return nullptr;
+
+				_unhash(*line);
+				_hash(*line, nr);
+			}
+			_lru_touch(*line);
+			return line;
+		}
+
+		void _read_ahead_from(Line const &current)
+		{
+			Genode::uint64_t const nr = current.nr + 1;
+			for (unsigned i = 0; i < _read_ahead && nr + i < _num_line_nrs(); i++) {
+
+				if (_lookup(nr + i))
+					continue;
+
+				Line *line = _victim(false, &current);
+				if (!line)
+					return;
+
+				_unhash(*line);
+				_hash(*line, nr + i);
+				_lru_touch(*line);
+
+				if (!_try_load(*line)) {
+					_unhash(*line);
+					return;
+				}
+			}
+		}
+
+		/**
+		 * Make line content valid, loading it from the device if needed
+		 */
+		bool _validate(Line &line)
+		{
+			while (line.state == Line::EMPTY && !_try_load(line)) {
+				if (!_io.in_flight())
+					return false;
+				_io.wait_for_ack();
+			}
+
+			while (line.state == Line::LOADING)
+				_io.wait_for_ack();
+
+			return line.state == Line::VALID;
+		}
+
+
+		/******************************
+		 ** Io::Completion interface **
+		 ******************************/
+
+		void io_completed(Block::Packet_descriptor const &packet,
+		                  char const *content) override
+		{
+			Genode::uint64_t const first = packet.block_number() / _line_blocks;
+			Genode::uint64_t const last  = (packet.block_number() +
+			                                packet.block_count() - 1) / _line_blocks;
+
+			for (Genode::uint64_t nr = first; nr <= last; nr++) {
+
+				Line *line = _lookup(nr);
+				if (!line)
+					continue;
+
+				if (packet.operation() == Block::Packet_descriptor::READ) {
+					if (line->state != Line::LOADING)
+						continue;
+
+					if (packet.succeeded()) {
+						Genode::memcpy(line->data, content + (nr - first)*_line_size,
+						               _blocks_of(*line)*_block_size);
+						line->state = Line::VALID;
+					} else {
+						_unhash(*line);
+					}
+					continue;
+				}
+				if (line->writing)
+					line->writing--;
+
+				/* keep the content of lines that could not be written back */
+				if (!packet.succeeded()) {
+					line->dirty = true;
+					_io_error   = true;
+					_write_errors++;
+				}
+			}
+		}
+
+		/**
+		 * Apply 'fn' to each line section covered by the byte range
+		 */
+		bool _for_each_section(file_size offset, size_t count, auto const &fn)
+		{
+			while (count) {
+				Genode::uint64_t const nr    = offset / _line_size;
+				size_t           const displ = (size_t)(offset % _line_size);
+				size_t           const len   = Genode::min(count, _line_size - displ);
+
+				Line *line = _acquire(nr);
+				if (!line || !fn(*line, displ, len))
+					return false;
+
+				offset += len;
+				count  -= len;
+			}
+			return true;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param max_request_blocks  maximum number of blocks that fit into
+		 *                            one request, limits the line size
+		 */
+		Cache(Genode::Allocator &alloc, Io &io, Block::Session::Info const &info,
+		      size_t cache_size, unsigned read_ahead,
+		      block_count_t max_request_blocks)
+		:
+			_alloc(alloc), _io(io),
+			_block_size(info.block_size),
+			_block_count(info.block_count),
+			_line_blocks((block_count_t)Genode::max((size_t)1,
+			             Genode::min(LINE_SIZE / _block_size, (size_t)max_request_blocks))),
+			_line_size(_line_blocks*_block_size),
+			_num_lines((unsigned)Genode::max((size_t)2, cache_size / _line_size)),
+			_read_ahead(Genode::min(read_ahead, _num_lines / 2)),
+			_max_request_blocks(Genode::max(max_request_blocks, (block_count_t)1)),
+			_lines(new (alloc) Line[_num_lines]),
+			_buckets(new (alloc) Line *[_num_lines]),
+			_data((char *)alloc.alloc(_num_lines*_line_size))
+		{
+			for (unsigned i = 0; i < _num_lines; i++) {
+				_buckets[i]   = nullptr;
+				_lines[i].data = _data + i*_line_size;
+				_lru_touch(_lines[i]);
+			}
+		}
+
+		~Cache()
+		{
+			if (!flush())
+				Genode::error("vfs_block: dropping cached blocks not written back");
+			_alloc.free(_data, _num_lines*_line_size);
+			destroy(_alloc, _buckets);
+			destroy(_alloc, _lines);
+		}
+
+		bool read(file_size offset, Byte_range_ptr const &dst)
+		{
+			_io.process_acks();
+
+			char *ptr = dst.start;
+			bool const result = _for_each_section(offset, dst.num_bytes,
+				[&] (Line &line, size_t displ, size_t len) {
+
+					if (line.state == Line::EMPTY)
+						while (!_try_load(line) && _io.in_flight())
+							_io.wait_for_ack();
+
+					/* issue read-ahead before waiting for the current line */
+					if (line.nr == _last_read + 1)
+						_read_ahead_from(line);
+					_last_read = line.nr;
+
+					if (!_validate(line))
+						return false;
+
+					Genode::memcpy(ptr, line.data + displ, len);
+					ptr += len;
+					return true;
+				});
+
+			/* let the server process read-ahead requests in the background */
+			_io.wakeup();
+			return result;
+		}
+
+		bool write(file_size offset, Const_byte_range_ptr const &src)
+		{
+			_io.process_acks();
+
+			char const *ptr = src.start;
+			bool const result = _for_each_section(offset, src.num_bytes,
+				[&] (Line &line, size_t displ, size_t len) {
+
+					/* a line that is overwritten entirely needs no load */
+					bool const complete = displ == 0 &&
+					                      len == _blocks_of(line)*_block_size;
+					if (complete && line.state == Line::EMPTY)
+						line.state = Line::VALID;
+
+					if (!_validate(line))
+						return false;
+
+					Genode::memcpy(line.data + displ, ptr, len);
+					line.dirty = true;
+					ptr += len;
+					return true;
+				});
+
+			/* let the server process write-backs of evicted lines */
+			_io.wakeup();
+			return result;
+		}
+
+		/**
+		 * Write back all dirty lines and wait for their completion
+		 *
+		 * \return false if writing back a line failed since the last flush,
+		 *         the affected lines stay dirty in this case
+		 */
+		bool flush()
+		{
+			unsigned const write_errors = _write_errors;
+
+			for (;;) {
+				bool dirty = false;
+				for (unsigned i = 0; i < _num_lines; i++) {
+					Line &line = _lines[i];
+					if (!line.dirty)
+						continue;
+
+					/* start runs at their first line */
+					Line const *pred = line.nr ? _lookup(line.nr - 1) : nullptr;
+					if (pred && pred->dirty && !pred->writing)
+						continue;
+
+					dirty = true;
+					_try_write_back(line);
+				}
+
+				/* do not retry failed write-backs within the same flush */
+				if (_write_errors != write_errors) {
+					_io.wait_until_idle();
+					break;
+				}
+
+				if (!_io.in_flight()) {
+					if (dirty)
+						_io_error = true;
+					break;
+				}
+				_io.wait_for_ack();
+			}
+			bool const result = !_io_error;
+			_io_error = false;
+			return result;
+		}
+};
+
+
 class Vfs::Block_file_system::Data_file_system : public Single_file_system
 {
 	private:
@@ -54,29 +665,65 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 
 		Block::Connection<>        &_block;
 		Block::Session::Info const &_info;
-		Block::Session::Tx::Source *_tx_source;
 
 		bool const _writeable;
 
+		Io                        _io;
+		Genode::Constructible<Cache> _cache { };
+
 		class Block_vfs_handle : public Single_vfs_handle
 		{
 			private:
 
-				Genode::Entrypoint                &_ep;
+				/*
+				 * Minimum size of the requests a bulk transfer is split into
+				 */
+				enum { MIN_REQUEST_SIZE = 32*1024 };
+
 				Genode::Allocator                 &_alloc;
 				char                              *_block_buffer;
 				unsigned                          &_block_buffer_count;
-				Block::Connection<>               &_block;
 				size_t                       const _block_size;
 				Block::sector_t              const _block_count;
-				Block::Session::Tx::Source        *_tx_source;
 				bool                         const _writeable;
+				Io                                &_io;
+				Cache                       *const _cache;
 
-				void _block_for_ack()
+				/**
+				 * State of the requests of one synchronous transfer
+				 */
+				struct Transfer : Io::Completion
 				{
-					while (!_tx_source->ack_avail())
-						_ep.wait_and_dispatch_one_io_signal();
-				}
+					char                 *buf;
+					Block::block_number_t first;
+					size_t                block_size;
+					unsigned              pending { 0 };
+					bool                  failed  { false };
+
+					Transfer(char *buf, Block::block_number_t first, size_t block_size)
+					: buf(buf), first(first), block_size(block_size) { }
+
+					/*
+					 * Noncopyable
+					 */
+					Transfer(Transfer const &);
+					Transfer &operator = (Transfer const &);
+
+					void io_completed(Block::Packet_descriptor const &packet,
+					                  char const *content) override
+					{
+						pending--;
+						if (!packet.succeeded()) {
+							failed = true;
+							return;
+						}
+						if (packet.operation() == Block::Packet_descriptor::READ)
+							Genode::memcpy(buf + (packet.block_number() - first)*block_size,
+							               content, packet.block_count()*block_size);
+					}
+				};
+
+				file_size _device_size() const { return _block_count*_block_size; }
 
 				/*
 				 * Noncopyable
@@ -84,90 +731,104 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 				Block_vfs_handle(Block_vfs_handle const &);
 				Block_vfs_handle &operator = (Block_vfs_handle const &);
 
+				/**
+				 * Transfer blocks with all requests of the transfer in flight
+				 * at once
+				 */
 				size_t _block_io(file_size nr, void *buf, file_size sz,
 				                 bool write, bool bulk = false)
 				{
 					Block::Packet_descriptor::Opcode op;
 					op = write ? Block::Packet_descriptor::WRITE : Block::Packet_descriptor::READ;
 
-					size_t packet_count = bulk ? (size_t)(sz / _block_size) : 1;
+					Block::block_count_t const total =
+						bulk ? (Block::block_count_t)(sz / _block_size) : 1;
 
-					Block::Packet_descriptor packet;
+					Block::block_count_t max_count =
+						Genode::max((Block::block_count_t)_block_buffer_count,
+						            (Block::block_count_t)(MIN_REQUEST_SIZE / _block_size));
 
-					/* sanity check */
-					if (packet_count > _block_buffer_count) {
-						packet_count = _block_buffer_count;
-					}
+					Transfer transfer { (char *)buf, nr, _block_size };
+					Block::block_count_t submitted = 0;
 
-					while (true) {
-						try {
-							packet = _block.alloc_packet(packet_count * _block_size);
-							break;
-						} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+					while ((submitted < total && !transfer.failed) || transfer.pending) {
 
-							while (!_tx_source->ready_to_submit())
-								_ep.wait_and_dispatch_one_io_signal();
+						if (submitted < total && !transfer.failed) {
 
-							if (packet_count > 1) {
-								packet_count /= 2;
+							Block::block_count_t const count =
+								Genode::min(total - submitted, max_count);
+
+							char const *src = (char const *)buf + submitted*_block_size;
+							if (_io.try_submit(op, nr + submitted, count, transfer,
+							                   [&] (char *content) {
+							                       Genode::memcpy(content, src, count*_block_size); }))
+							{
+								submitted += count;
+								transfer.pending++;
+								continue;
+							}
+
+							/* shrink requests that do not fit into the empty packet buffer */
+							if (!_io.in_flight()) {
+								if (max_count > 1) {
+									max_count /= 2;
+									continue;
+								}
+								transfer.failed = true;
+								continue;
 							}
 						}
+						_io.wait_for_ack();
 					}
 
-					Block::Packet_descriptor p(packet, op, nr, packet_count);
-
-					if (write)
-						Genode::memcpy(_tx_source->packet_content(p), buf, packet_count * _block_size);
-
-					_tx_source->submit_packet(p);
-
-					_block_for_ack();
-
-					p = _tx_source->get_acked_packet();
-
-					if (!p.succeeded()) {
-						Genode::error("Could not read block(s)");
-						_tx_source->release_packet(p);
+					if (transfer.failed) {
+						Genode::error("Could not ", write ? "write" : "read", " block(s)");
 						return 0;
 					}
-
-					if (!write)
-						Genode::memcpy(buf, _tx_source->packet_content(p), packet_count * _block_size);
-
-					_tx_source->release_packet(p);
-					return packet_count * _block_size;
+					return total * _block_size;
 				}
 
 			public:
 
 				Block_vfs_handle(Directory_service                 &ds,
 				                 File_io_service                   &fs,
-				                 Genode::Entrypoint                &ep,
 				                 Genode::Allocator                 &alloc,
 				                 char                              *block_buffer,
 				                 unsigned                          &block_buffer_count,
-				                 Block::Connection<>               &block,
 				                 size_t                             block_size,
 				                 Block::sector_t                    block_count,
-				                 Block::Session::Tx::Source        *tx_source,
-				                 bool                               writeable)
+				                 bool                               writeable,
+				                 Io                                &io,
+				                 Cache                             *cache)
 				:
 					Single_vfs_handle(ds, fs, alloc, 0),
-					_ep(ep),
 					_alloc(alloc),
 					_block_buffer(block_buffer),
 					_block_buffer_count(block_buffer_count),
-					_block(block),
 					_block_size(block_size),
 					_block_count(block_count),
-					_tx_source(tx_source),
-					_writeable(writeable)
+					_writeable(writeable),
+					_io(io),
+					_cache(cache)
 				{ }
 
 				Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
 				{
 					file_size seek_offset = seek();
 
+					if (_cache) {
+						size_t const count = (seek_offset >= _device_size()) ? 0
+						                   : (size_t)Genode::min((file_size)dst.num_bytes,
+						                                         _device_size() - seek_offset);
+
+						if (!_cache->read(seek_offset, { dst.start, count })) {
+							Genode::error("error while reading from block device");
+							return READ_ERR_INVALID;
+						}
+						out_count = count;
+						return READ_OK;
+					}
+
 					size_t count = dst.num_bytes;
 					size_t read = 0;
 
@@ -237,6 +898,21 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 
 					file_size seek_offset = seek();
 
+					if (_cache) {
+						size_t const count = (seek_offset >= _device_size()) ? 0
+						                   : (size_t)Genode::min((file_size)src.num_bytes,
+						                                         _device_size() - seek_offset);
+						if (!count && src.num_bytes)
+							return WRITE_ERR_INVALID;
+
+						if (!_cache->write(seek_offset, { src.start, count })) {
+							Genode::error("error while writing to block device");
+							return WRITE_ERR_INVALID;
+						}
+						out_count = count;
+						return WRITE_OK;
+					}
+
 					size_t written = 0;
 					size_t count = src.num_bytes;
 
@@ -310,28 +986,26 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 
 				Sync_result sync() override
 				{
-					/*
-					 * Just in case bail if we cannot submit the packet.
-					 * (Since the plugin operates in a synchronous fashion
-					 * that should not happen.)
-					 */
-					if (!_tx_source->ready_to_submit()) {
-						Genode::error("vfs_block: could not sync blocks");
+					if (_cache && !_cache->flush()) {
+						Genode::error("vfs_block: could not write back cached blocks");
 						return SYNC_ERR_INVALID;
 					}
 
-					Block::Packet_descriptor p =
-						Block::Session::sync_all_packet_descriptor(
-							_block.info(), Block::Session::Tag { 0 });
-
-					_tx_source->submit_packet(p);
+					Transfer transfer { nullptr, 0, _block_size };
+					while (!_io.try_submit(Block::Packet_descriptor::SYNC, 0,
+					                       _block_count, transfer, [] (char *) { })) {
 
-					_block_for_ack();
-
-					p = _tx_source->get_acked_packet();
-					_tx_source->release_packet(p);
+						if (!_io.in_flight()) {
+							Genode::error("vfs_block: could not sync blocks");
+							return SYNC_ERR_INVALID;
+						}
+						_io.wait_for_ack();
+					}
+					transfer.pending++;
+					while (transfer.pending)
+						_io.wait_for_ack();
 
-					if (!p.succeeded()) {
+					if (transfer.failed) {
 						/* only warn once if sync is not supported */
 						static bool print_sync_failed = true;
 						if (print_sync_failed) {
@@ -350,11 +1024,22 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param cache_size          size of the block cache, 0 disables
+		 *                            the cache
+		 * \param read_ahead          number of cache lines to read ahead
+		 * \param max_request_blocks  maximum number of blocks per request
+		 */
 		Data_file_system(Vfs::Env                   &env,
 		                 Block::Connection<>        &block,
 		                 Block::Session::Info const &info,
 		                 Name                 const &name,
-		                 unsigned                    block_buffer_count)
+		                 unsigned                    block_buffer_count,
+		                 size_t                      cache_size,
+		                 unsigned                    read_ahead,
+		                 Block::block_count_t        max_request_blocks)
 		:
 			Single_file_system { Node_type::CONTINUOUS_FILE, name.string(),
 			                     info.writeable ? Node_rwx::rw() : Node_rwx::ro(),
@@ -364,15 +1049,21 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 			_block_buffer_count(block_buffer_count),
 			_block(block),
 			_info(info),
-			_tx_source(_block.tx()),
-			_writeable(_info.writeable)
+			_writeable(_info.writeable),
+			_io(_env.env().ep(), _block, _info)
 		{
 			_block_buffer = new (_env.alloc())
 				char[_block_buffer_count * _info.block_size];
+
+			if (cache_size)
+				_cache.construct(_env.alloc(), _io, _info, cache_size,
+				                 read_ahead, max_request_blocks);
 		}
 
 		~Data_file_system()
 		{
+			_cache.destruct();
+			_io.wait_until_idle();
 			destroy(_env.alloc(), _block_buffer);
 		}
 
@@ -392,15 +1083,15 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 
 			try {
 				*out_handle = new (alloc) Block_vfs_handle(*this, *this,
-				                                           _env.env().ep(),
 				                                           alloc,
 				                                           _block_buffer,
 				                                           _block_buffer_count,
-				                                           _block,
 				                                           _info.block_size,
 				                                           _info.block_count,
-				                                           _tx_source,
-				                                           _info.writeable);
+				                                           _info.writeable,
+				                                           _io,
+				                                           _cache.constructed()
+				                                           ? &*_cache : nullptr);
 				return OPEN_OK;
 			}
 			catch (Genode::Out_of_ram)  { return OPEN_ERR_OUT_OF_RAM; }
@@ -437,8 +1128,7 @@ struct Vfs::Block_file_system::Local_factory : File_system_factory
 
 	Genode::Allocator_avl _tx_block_alloc { &_env.alloc() };
 
-	Block::Connection<> _block {
-		_env.env(), &_tx_block_alloc, 128*1024, _label.string() };
+	Block::Connection<> _block;
 
 	Block::Session::Info const _info { _block.info() };
 
@@ -479,12 +1169,30 @@ struct Vfs::Block_file_system::Local_factory : File_system_factory
 		return config.attribute_value("block_buffer_count", 1U);
 	}
 
+	static size_t io_buffer_size(Xml_node const &config)
+	{
+		return config.attribute_value("io_buffer", Genode::Number_of_bytes(128*1024));
+	}
+
+	static size_t cache_size(Xml_node const &config)
+	{
+		return config.attribute_value("cache", Genode::Number_of_bytes(0));
+	}
+
+	static unsigned read_ahead(Xml_node const &config)
+	{
+		return config.attribute_value("read_ahead", 8U);
+	}
+
 	Local_factory(Vfs::Env &env, Xml_node const &config)
 	:
 		_label   { config.attribute_value("label", Label("")) },
 		_name    { name(config) },
 		_env     { env },
-		_data_fs { _env, _block, _info, name(config), buffer_count(config) }
+		_block   { _env.env(), &_tx_block_alloc, io_buffer_size(config), _label.string() },
+		_data_fs { _env, _block, _info, name(config), buffer_count(config),
+		           cache_size(config), read_ahead(config),
+		           (Block::block_count_t)(io_buffer_size(config) / 2 / _info.block_size) }
 	{
 		_block.sigh(_block_signal_handler);
 		_info_fs       .value(Info { _info });
@@ -18,6 +18,7 @@
 #include <ram_fs/param.h>
 #include <vfs/file_system.h>
 #include <dataspace/client.h>
+#include <base/attached_ram_dataspace.h>
 #include <util/avl_tree.h>
 
 namespace Vfs { class Ram_file_system; }
@@ -35,6 +36,10 @@ namespace Vfs_ram {
 
 	class Node;
 	class File;
+	class Chunk_file;
+	class Extent;
+	class Extent_pool;
+	class Extent_file;
 	class Symlink;
 	class Directory;
 
@@ -252,6 +257,26 @@ class Vfs_ram::Node : private Genode::Avl_node<Node>
 
 
 class Vfs_ram::File : public Vfs_ram::Node
+{
+	public:
+
+		File(char const * const name) : Node(name) { }
+
+		/**
+		 * Return dataspace that holds the file content
+		 *
+		 * A file that keeps its content in a contiguous dataspace hands out
+		 * this dataspace instead of a copy. An invalid capability tells the
+		 * caller to fall back to copying the content.
+		 */
+		virtual Dataspace_capability export_dataspace() { return { }; }
+};
+
+
+/**
+ * File that stores its content in a radix tree of 4-KiB chunks
+ */
+class Vfs_ram::Chunk_file : public Vfs_ram::File
 {
 	private:
 
@@ -266,8 +291,8 @@ class Vfs_ram::File : public Vfs_ram::Node
 
 	public:
 
-		File(char const * const name, Allocator &alloc)
-		: Node(name), _chunk(alloc, Seek{0}) { }
+		Chunk_file(char const * const name, Allocator &alloc)
+		: File(name), _chunk(alloc, Seek{0}) { }
 
 		size_t read(Byte_range_ptr const &dst, Seek seek) override
 		{
@@ -346,6 +371,278 @@ class Vfs_ram::File : public Vfs_ram::Node
 };
 
 
+/**
+ * Contiguous RAM dataspace that holds the content of an extent file
+ *
+ * An extent may outlive its file, or be replaced by a larger one, while
+ * its dataspace is still exported. It is destroyed once it is neither
+ * used by a file nor exported.
+ */
+class Vfs_ram::Extent : public Genode::List<Extent>::Element
+{
+	private:
+
+		friend class Extent_pool;
+
+		using Local_rm = Genode::Env::Local_rm;
+
+		Attached_ram_dataspace _ds;
+
+		bool     _used    = true;   /* content of a file */
+		unsigned _exports = 0;
+
+	public:
+
+		Extent(Ram_allocator &ram, Local_rm &rm, size_t size)
+		: _ds(ram, rm, size) { }
+
+		size_t size() const { return _ds.size(); }
+
+		char *base() const { return _ds.local_addr<char>(); }
+};
+
+
+/**
+ * Allocator of extents that keeps track of exported extents
+ *
+ * Exported dataspaces are released by capability, which stays valid
+ * when the exporting file is renamed, replaced, or unlinked in between.
+ */
+class Vfs_ram::Extent_pool
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Extent_pool(Extent_pool const &);
+		Extent_pool &operator = (Extent_pool const &);
+
+		using Local_rm = Genode::Env::Local_rm;
+
+		Allocator     &_alloc;
+		Ram_allocator &_ram;
+		Local_rm      &_rm;
+
+		List<Extent> _exported { };
+
+		void _destroy_if_unused(Extent &extent)
+		{
+			if (extent._used || extent._exports)
+				return;
+
+			destroy(_alloc, &extent);
+		}
+
+	public:
+
+		Extent_pool(Allocator &alloc, Ram_allocator &ram, Local_rm &rm)
+		: _alloc(alloc), _ram(ram), _rm(rm) { }
+
+		~Extent_pool()
+		{
+			while (Extent * const extent = _exported.first()) {
+				_exported.remove(extent);
+				destroy(_alloc, extent);
+			}
+		}
+
+		/**
+		 * Allocate extent of 'size' bytes for use by a file
+		 *
+		 * \throw Out_of_memory
+		 */
+		Extent &alloc(size_t size)
+		{
+			try { return *new (_alloc) Extent(_ram, _rm, size); }
+			catch (Out_of_ram)                          { throw Out_of_memory(); }
+			catch (Out_of_caps)                         { throw Out_of_memory(); }
+			catch (Attached_dataspace::Region_conflict) { throw Out_of_memory(); }
+		}
+
+		/**
+		 * Drop extent from its file
+		 */
+		void drop(Extent &extent)
+		{
+			extent._used = false;
+			_destroy_if_unused(extent);
+		}
+
+		Dataspace_capability export_dataspace(Extent &extent)
+		{
+			if (extent._exports++ == 0)
+				_exported.insert(&extent);
+
+			return extent._ds.cap();
+		}
+
+		/**
+		 * Drop one export of the dataspace 'ds_cap'
+		 *
+		 * \return  false if 'ds_cap' does not belong to an exported extent
+		 */
+		bool release(Dataspace_capability ds_cap)
+		{
+			Extent *extent = _exported.first();
+			for (; extent && extent->_ds.cap() != ds_cap; extent = extent->next());
+
+			if (!extent)
+				return false;
+
+			if (--extent->_exports == 0) {
+				_exported.remove(extent);
+				_destroy_if_unused(*extent);
+			}
+			return true;
+		}
+};
+
+
+/**
+ * File that stores its content in one contiguous RAM dataspace
+ *
+ * The extent grows by doubling its capacity, which keeps the amortized cost
+ * of appending data constant. Since the content is contiguous, each read or
+ * write is a single 'memcpy' and the dataspace can be handed out for shared
+ * mappings without copying. All bytes of the extent beyond '_length' are
+ * zero.
+ */
+class Vfs_ram::Extent_file : public Vfs_ram::File
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Extent_file(Extent_file const &);
+		Extent_file &operator = (Extent_file const &);
+
+		static constexpr size_t MIN_CAPACITY = 64*1024;
+
+		Extent_pool &_pool;
+		Extent      *_extent = nullptr;
+		size_t       _length = 0;
+
+		size_t _capacity() const { return _extent ? _extent->size() : 0; }
+
+		char *_base() const { return _extent->base(); }
+
+		void _drop_extent()
+		{
+			if (_extent)
+				_pool.drop(*_extent);
+
+			_extent = nullptr;
+		}
+
+		/**
+		 * Make sure that the extent can hold 'size' bytes
+		 *
+		 * \param exact  allocate 'size' bytes instead of doubling the capacity
+		 *
+		 * \throw Out_of_memory
+		 */
+		void _reserve(size_t const size, bool const exact)
+		{
+			size_t const capacity = _capacity();
+			if (size <= capacity)
+				return;
+
+			size_t new_capacity = exact ? size : max(capacity, MIN_CAPACITY);
+			while (new_capacity < size && new_capacity <= ~(size_t)0 / 2)
+				new_capacity *= 2;
+
+			new_capacity = align_addr(max(new_capacity, size), 12);
+
+			Extent &extent = _pool.alloc(new_capacity);
+
+			if (_extent)
+				memcpy(extent.base(), _base(), _length);
+
+			_drop_extent();
+			_extent = &extent;
+		}
+
+	public:
+
+		Extent_file(char const * const name, Extent_pool &pool)
+		: File(name), _pool(pool) { }
+
+		~Extent_file() { _drop_extent(); }
+
+		size_t read(Byte_range_ptr const &dst, Seek seek) override
+		{
+			if (seek.value >= _length)
+				return 0;
+
+			size_t const len = min(dst.num_bytes, _length - seek.value);
+
+			memcpy(dst.start, _base() + seek.value, len);
+
+			return len;
+		}
+
+		Vfs::File_io_service::Read_result complete_read(Byte_range_ptr const &dst,
+		                                                Seek seek, size_t &out_count) override
+		{
+			out_count = read(dst, seek);
+			return Vfs::File_io_service::READ_OK;
+		}
+
+		size_t write(Const_byte_range_ptr const &src, Seek const seek) override
+		{
+			size_t const at  = (seek.value == ~0UL) ? _length : seek.value;
+			size_t const end = at + src.num_bytes;
+
+			if (!src.num_bytes || end < at)
+				return 0;
+
+			try { _reserve(end, false); }
+			catch (Out_of_memory) { return 0; }
+
+			memcpy(_base() + at, src.start, src.num_bytes);
+
+			_length = max(_length, end);
+
+			return src.num_bytes;
+		}
+
+		size_t length() override { return _length; }
+
+		void truncate(Seek size) override
+		{
+			if (size.value > _length) {
+				_reserve(size.value, true);
+
+			} else if (size.value == 0) {
+
+				/* give the memory of an emptied file back */
+				_drop_extent();
+
+			} else if (_extent) {
+				memset(_base() + size.value, 0, _length - size.value);
+			}
+
+			_length = size.value;
+		}
+
+		/**
+		 * Return the extent, which may be larger than the file
+		 *
+		 * Modifications of the dataspace are visible to all users of the
+		 * file and vice versa until the extent gets replaced.
+		 */
+		Dataspace_capability export_dataspace() override
+		{
+			if (!_extent)
+				return { };
+
+			return _pool.export_dataspace(*_extent);
+		}
+};
+
+
 class Vfs_ram::Symlink : public Vfs_ram::Node
 {
 	private:
@@ -495,8 +792,22 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 		friend class Genode::List<Vfs_ram::Watch_handle>;
 
-		Vfs::Env           &_env;
-		Vfs_ram::Directory  _root = { "" };
+		Vfs::Env            &_env;
+		Vfs_ram::Extent_pool _extents;
+		Vfs_ram::Directory   _root = { "" };
+
+		/* store files in contiguous extents instead of chunks */
+		bool const _extent_storage;
+
+		Vfs_ram::File *_new_file(char const *name)
+		{
+			using namespace Vfs_ram;
+
+			if (_extent_storage)
+				return new (_env.alloc()) Extent_file(name, _extents);
+
+			return new (_env.alloc()) Chunk_file(name, _env.alloc());
+		}
 
 		Vfs_ram::Node *lookup(char const *path, bool return_parent = false)
 		{
@@ -572,7 +883,12 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 	public:
 
-		Ram_file_system(Vfs::Env &env, Genode::Xml_node const &) : _env(env) { }
+		Ram_file_system(Vfs::Env &env, Genode::Xml_node const &config)
+		:
+			_env(env),
+			_extents(_env.alloc(), _env.env().ram(), _env.env().rm()),
+			_extent_storage(config.attribute_value("storage", String<8>()) == "extent")
+		{ }
 
 		~Ram_file_system() { _root.empty(_env.alloc()); }
 
@@ -626,7 +942,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 				if (strlen(name) >= MAX_NAME_LEN)
 					return OPEN_ERR_NAME_TOO_LONG;
 
-				try { file = new (_env.alloc()) File(name, _env.alloc()); }
+				try { file = _new_file(name); }
 				catch (Out_of_memory) { return OPEN_ERR_NO_SPACE; }
 				parent->adopt(file);
 				parent->notify();
@@ -906,6 +1222,10 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			if (!file)
 				return { };
 
+			Dataspace_capability const ds_cap = file->export_dataspace();
+			if (ds_cap.valid())
+				return ds_cap;
+
 			size_t const len = file->length();
 
 			return _env.env().ram().try_alloc(len).convert<Dataspace_capability>(
@@ -928,8 +1248,19 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			);
 		}
 
+		bool dataspace_without_copy(char const * const path) override
+		{
+			/* an empty extent file has no extent to hand out */
+			auto const file = dynamic_cast<Vfs_ram::Extent_file *>(lookup(path));
+			return file && file->length();
+		}
+
 		void release(char const *, Dataspace_capability ds_cap) override
 		{
+			/* the file of an extent may have been renamed or unlinked since */
+			if (_extents.release(ds_cap))
+				return;
+
 			_env.env().ram().free(
 				static_cap_cast<Genode::Ram_dataspace>(ds_cap));
 		}
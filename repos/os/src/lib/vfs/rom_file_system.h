@@ -180,6 +180,11 @@ class Vfs::Rom_file_system : public Single_file_system
 			return _rom.cap();
 		}
 
+		bool dataspace_without_copy(char const *path) override
+		{
+			return _single_file(path);
+		}
+
 		/********************************
 		 ** File I/O service interface **
 		 ********************************/
@@ -2,6 +2,17 @@
  * \brief  Component that caches files to be served as ROMs
  * \author Emery Hemingway
  * \date   2018-04-12
+ *
+ * ROM sessions are delivered as soon as the file is opened. The content is
+ * read in granules when a client touches it. Completely loaded ROMs with
+ * identical content share one RAM dataspace.
+ *
+ * With '<config access_report="yes">', the paths of the requested ROMs are
+ * reported as "accesses" in the order of their first request. With
+ * '<config prefetch="yes">', the ROMs listed in the "prefetch" ROM, which
+ * has the format of the "accesses" report, are loaded in the background at
+ * startup. Storing the report persistently and providing it as "prefetch"
+ * ROM at the next start thereby preloads the ROMs of the previous run.
  */
 
 /*
@@ -22,6 +33,8 @@
 #include <base/session_label.h>
 #include <base/heap.h>
 #include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/reporter.h>
 
 /* local session-requests utility */
 #include "session_requests.h"
@@ -39,8 +52,7 @@ namespace Cached_fs_rom {
 	struct Cached_rom;
 	using Cache_space = Genode::Id_space<Cached_rom>;
 
-	struct Transfer;
-	using Transfer_space = Genode::Id_space<Transfer>;
+	using Load_space = Genode::Id_space<Cached_rom>;
 
 	class Session_component;
 	using Session_space = Genode::Id_space<Session_component>;
@@ -52,194 +64,461 @@ namespace Cached_fs_rom {
 }
 
 
+namespace Cached_fs_rom {
+
+	/**
+	 * Open a file handle
+	 */
+	static File_handle open_file(File_system::Session &fs, Path const &file_path)
+	{
+		using namespace File_system;
+
+		Path dir_path(file_path);
+		dir_path.strip_last_element();
+		Path file_name(file_path);
+		file_name.keep_only_last_element();
+
+		Dir_handle parent_handle = fs.dir(dir_path.base(), false);
+		Handle_guard parent_guard(fs, parent_handle);
+
+		return fs.file(
+			parent_handle, file_name.base() + 1,
+			File_system::READ_ONLY, false);
+	}
+}
+
+
 struct Cached_fs_rom::Cached_rom final
 {
 	Cached_rom(Cached_rom const &);
 	Cached_rom &operator = (Cached_rom const &);
 
-	Genode::Env   &env;
-	Rm_connection &rm_connection;
+	/*
+	 * The ROM content is populated lazily in granules. A granule is read
+	 * from the file system when a client accesses it for the first time,
+	 * or when the ROM is prefetched.
+	 */
+	enum { GRANULE_SIZE = 64*1024, READ_AHEAD = 3, PREFETCH_GRANULES = 16,
+	       MAX_READ_ERRORS = 3 };
+
+	enum class Granule : uint8_t { ABSENT, DEMANDED, LOADING, PRESENT };
+
+	Genode::Env          &env;
+	Allocator            &alloc;
+	Rm_connection        &rm_connection;
+	File_system::Session &fs;
+	Load_space           &load_space;
+
+	Path const path;
 
 	size_t const file_size;
+	size_t const ds_size      = align_addr(max(file_size, (size_t)1), 12);
+	size_t const num_granules = (ds_size + GRANULE_SIZE - 1) / GRANULE_SIZE;
 
 	/**
 	 * Backing RAM dataspace
 	 *
-	 * This shall be valid even if the file is empty.
+	 * The dataspace is released if the content turns out to be identical
+	 * to the one of another cached ROM.
 	 */
-	Attached_ram_dataspace ram_ds {
-		env.ram(), env.rm(), file_size ? file_size : 1 };
+	Constructible<Attached_ram_dataspace> ram_ds { };
 
 	/**
 	 * Read-only region map exposed as ROM module to the client
 	 */
-	Region_map_client      rm { rm_connection.create(ram_ds.size()) };
-	addr_t                 rm_attachment { };
-	Dataspace_capability   rm_ds { };
+	Capability<Region_map> rm_cap { rm_connection.create(ds_size) };
+	Region_map_client      rm { rm_cap };
+	Dataspace_capability   rm_ds { rm.dataspace() };
 
-	Path const path;
+	/**
+	 * Population state per granule, the first granule of each attached
+	 * range is tagged in 'region_start'
+	 */
+	Granule *granules     { (Granule *)alloc.alloc(num_granules*sizeof(Granule)) };
+	bool    *region_start { (bool *)alloc.alloc(num_granules*sizeof(bool)) };
+	size_t   num_present  = 0;
 
-	Cache_space::Element cache_elem;
+	/* load all granules, not only the demanded ones */
+	bool prefetch = false;
+
+	/*
+	 * File handle and id-space element for routing acks while loading
+	 *
+	 * The file is open only while granules are to be loaded, which keeps
+	 * the number of handles at the file-system server low.
+	 */
+	File_system::File_handle            handle    { ~0UL };
+	bool                                file_open = false;
+	Constructible<Load_space::Element>  load_elem { };
+
+	/* outstanding read request */
+	bool   in_flight  = false;
+	size_t load_first = 0;
+	size_t load_count = 0;
+
+	/*
+	 * Content that cannot be read is never exposed, the ROM is not handed
+	 * out to new sessions after repeated read errors
+	 */
+	unsigned read_errors = 0;
+	bool     failed      = false;
+
+	Signal_handler<Cached_rom> fault_handler {
+		env.ep(), *this, &Cached_rom::_handle_fault };
+
+	/* content hash, valid when completed */
+	uint64_t hash = 0;
+
+	/* ROM with identical content whose dataspace is used by this ROM */
+	Cached_rom *origin = nullptr;
 
-	Transfer *transfer = nullptr;
+	Cache_space::Element cache_elem;
 
 	/**
 	 * Reference count of cache entry
 	 */
 	int _ref_count = 0;
 
-	Cached_rom(Cache_space   &cache_space,
-	           Env           &env,
-	           Rm_connection &rm,
-	           Path const    &file_path,
-	           size_t         size)
-	:
-		env(env), rm_connection(rm), file_size(size),
-		path(file_path),
-		cache_elem(*this, cache_space)
+	struct Guard
+	{
+		Cached_rom &_rom;
+
+		Guard(Cached_rom &rom) : _rom(rom) {
+			++_rom._ref_count; }
+		~Guard() {
+			--_rom._ref_count; };
+	};
+
+	Constructible<Guard> origin_guard { };
+
+	/**
+	 * Attach dataspace range into the region map of the ROM
+	 */
+	void _attach(Dataspace_capability ds, addr_t at, size_t size)
 	{
-		if (size == 0)
-			complete();
+		for (bool done = false; !done; )
+			rm.attach(ds, {
+				.size       = size,
+				.offset     = at,
+				.use_at     = true,
+				.at         = at,
+				.executable = true,
+				.writeable  = false
+			}).with_result(
+				[&] (Region_map::Range) { done = true; },
+				[&] (Region_map::Attach_error e) {
+					switch (e) {
+					case Region_map::Attach_error::OUT_OF_RAM:
+						rm_connection.upgrade_ram(8*1024); break;
+					case Region_map::Attach_error::OUT_OF_CAPS:
+						rm_connection.upgrade_caps(2); break;
+					case Region_map::Attach_error::REGION_CONFLICT:
+					case Region_map::Attach_error::INVALID_DATASPACE:
+						error(path, ": failed to attach ROM content");
+						done = true;
+					}
+				});
 	}
 
 	/**
-	 * Destructor
+	 * Submit read request for the next granules to load
 	 */
-	~Cached_rom()
+	void _submit_next_request()
 	{
-		if (rm_attachment)
-			rm.detach(rm_attachment);
+		if (in_flight || failed || completed())
+			return;
+
+		/* demanded granules take precedence over prefetching */
+		size_t first = num_granules;
+		for (size_t i = 0; i < num_granules && first == num_granules; i++)
+			if (granules[i] == Granule::DEMANDED)
+				first = i;
+
+		for (size_t i = 0; prefetch && i < num_granules && first == num_granules; i++)
+			if (granules[i] == Granule::ABSENT)
+				first = i;
+
+		if (first == num_granules) {
+			_close_file();
+			return;
+		}
+
+		if (!_open_file()) {
+			_fail();
+			return;
+		}
+
+		size_t const max_count = prefetch ? PREFETCH_GRANULES : 1 + READ_AHEAD;
+
+		size_t count = 1;
+		while (count < max_count && first + count < num_granules
+		    && granules[first + count] != Granule::PRESENT
+		    && granules[first + count] != Granule::LOADING)
+			count++;
+
+		size_t const offset = first*GRANULE_SIZE;
+		size_t const length = min(count*GRANULE_SIZE, file_size - offset);
+
+		if (!fs.tx()->ready_to_submit())
+			return;
+
+		File_system::Packet_descriptor raw_packet { };
+		try { raw_packet = fs.tx()->alloc_packet(length); }
+		catch (Packet_alloc_failed) {
+			/* retried when another request is acknowledged */
+			return; }
+
+		fs.tx()->submit_packet(File_system::Packet_descriptor(
+			raw_packet, handle, File_system::Packet_descriptor::READ,
+			length, offset));
+
+		for (size_t i = first; i < first + count; i++)
+			granules[i] = Granule::LOADING;
+
+		in_flight  = true;
+		load_first = first;
+		load_count = count;
 	}
 
-	bool completed() const { return rm_ds.valid(); }
-	bool unused()    const { return (_ref_count < 1); }
+	void _handle_fault()
+	{
+		Region_map::Fault const fault = rm.fault();
+
+		if (fault.type == Region_map::Fault::Type::NONE || fault.addr >= ds_size)
+			return;
+
+		Granule &granule = granules[fault.addr / GRANULE_SIZE];
+		if (granule == Granule::ABSENT)
+			granule = Granule::DEMANDED;
 
-	void complete()
+		_submit_next_request();
+	}
+
+	bool _open_file()
 	{
-		/* attach dataspace read-only into region map */
-		rm_attachment = rm.attach(ram_ds.cap(), {
-			.size       = ram_ds.size(),
-			.offset     = { },
-			.use_at     = { },
-			.at         = { },
-			.executable = true,
-			.writeable  = false
-		}).convert<addr_t>(
-			[&] (Region_map::Range range)  { return range.start; },
-			[&] (Region_map::Attach_error) {
-				error("Cached_rom failed to locally attach managed dataspace");
-				return 0UL;
-			}
-		);
-		rm_ds = rm.dataspace();
+		if (file_open)
+			return true;
+
+		try { handle = open_file(fs, path); }
+		catch (...) {
+			error(path, ": failed to open file");
+			return false;
+		}
+
+		file_open = true;
+		load_elem.construct(*this, load_space, Load_space::Id { handle.value });
+		return true;
+	}
+
+	void _close_file()
+	{
+		load_elem.destruct();
+
+		if (file_open)
+			fs.close(handle);
+
+		file_open = false;
 	}
 
 	/**
-	 * Return dataspace with content of file
+	 * Stop loading and expose the content read so far
+	 *
+	 * Clients that fault on content that cannot be read must not block
+	 * forever. Hence, the whole backing dataspace is attached, which
+	 * leaves the unread parts zero-filled. The ROM is not handed out to
+	 * new sessions.
 	 */
-	Rom_dataspace_capability dataspace() const {
-		return static_cap_cast<Rom_dataspace>(rm_ds); }
+	void _fail()
+	{
+		error(path, ": content incomplete, unread parts are zero-filled");
 
-	struct Guard
+		failed = true;
+		_close_file();
+
+		for (size_t i = 0; i < num_granules; i++)
+			if (region_start[i]) {
+				rm.detach(i*GRANULE_SIZE);
+				region_start[i] = false;
+			}
+
+		_attach(ram_ds->cap(), 0, ds_size);
+	}
+
+	static uint64_t _hash(uint64_t const *words, size_t num_words)
 	{
-		Cached_rom &_rom;
+		/* FNV-1a over machine words */
+		uint64_t h = 0xcbf29ce484222325ULL;
+		for (size_t i = 0; i < num_words; i++)
+			h = (h ^ words[i])*0x100000001b3ULL;
+		return h;
+	}
 
-		Guard(Cached_rom &rom) : _rom(rom) {
-			++_rom._ref_count; }
-		~Guard() {
-			--_rom._ref_count; };
-	};
-};
+	/**
+	 * Replace the granule-wise attachments by one attachment of the
+	 * whole dataspace
+	 */
+	void _complete(Cache_space &cache)
+	{
+		_close_file();
 
+		for (size_t i = 0; i < num_granules; i++)
+			if (region_start[i])
+				rm.detach(i*GRANULE_SIZE);
 
-struct Cached_fs_rom::Transfer final
-{
-		Cached_rom                    &_cached_rom;
-		Cached_rom::Guard              _cache_guard { _cached_rom };
+		hash = _hash(ram_ds->local_addr<uint64_t const>(), ds_size / sizeof(uint64_t));
 
-		File_system::Session          &_fs;
-		File_system::File_handle       _handle;
+		/* look for a completed ROM with identical content */
+		cache.for_each<Cached_rom &>([&] (Cached_rom &other) {
+			if (origin || &other == this || !other.completed() || other.origin
+			 || other.file_size != file_size || other.hash != hash)
+				return;
 
-		File_system::file_size_t const _size;
-		File_system::seek_off_t        _seek = 0;
-		File_system::Packet_descriptor _raw_pkt = _alloc_packet();
-		File_system::Packet_guard      _packet_guard { *_fs.tx(), _raw_pkt };
+			if (memcmp(other.ram_ds->local_addr<char const>(),
+			           ram_ds->local_addr<char const>(), ds_size) == 0)
+				origin = &other;
+		});
 
-		Transfer_space::Element        _transfer_elem;
+		if (origin) {
+			origin_guard.construct(*origin);
+			_attach(origin->ram_ds->cap(), 0, ds_size);
+			ram_ds.destruct();
+			log(path, ": content shared with ", origin->path);
+			return;
+		}
 
-		/**
-		 * Allocate space in the File_system packet buffer
-		 *
-		 * \throw  Packet_alloc_failed
-		 */
-		File_system::Packet_descriptor _alloc_packet()
-		{
-			if (!_fs.tx()->ready_to_submit())
-				throw Packet_alloc_failed();
+		_attach(ram_ds->cap(), 0, ds_size);
+	}
 
-			size_t chunk_size = (size_t)min(_size, _fs.tx()->bulk_buffer_size()/2);
-			return _fs.tx()->alloc_packet(chunk_size);
+	Cached_rom(Cache_space              &cache_space,
+	           Load_space               &load_space,
+	           Genode::Env              &env,
+	           Allocator                &alloc,
+	           Rm_connection            &rm,
+	           File_system::Session     &fs,
+	           Path               const &file_path,
+	           size_t                    size)
+	:
+		env(env), alloc(alloc), rm_connection(rm), fs(fs),
+		load_space(load_space), path(file_path), file_size(size),
+		cache_elem(*this, cache_space)
+	{
+		try { ram_ds.construct(env.ram(), env.rm(), ds_size); }
+		catch (...) {
+			rm_connection.destroy(rm_cap);
+			alloc.free(granules, num_granules*sizeof(Granule));
+			alloc.free(region_start, num_granules*sizeof(bool));
+			throw;
 		}
 
-		void _submit_next_packet()
-		{
-			using namespace File_system;
+		for (size_t i = 0; i < num_granules; i++) {
+			granules[i]     = Granule::ABSENT;
+			region_start[i] = false;
+		}
 
-			File_system::Packet_descriptor
-			packet(_raw_pkt, _handle,
-			       File_system::Packet_descriptor::READ,
-			       _raw_pkt.size(), _seek);
+		this->rm.fault_handler(fault_handler);
 
-			_fs.tx()->submit_packet(packet);
+		if (size == 0) {
+			num_present = num_granules;
+			for (size_t i = 0; i < num_granules; i++)
+				granules[i] = Granule::PRESENT;
+			_complete(cache_space);
 		}
+	}
 
-	public:
+	/**
+	 * Destructor
+	 */
+	~Cached_rom()
+	{
+		_close_file();
+		rm_connection.destroy(rm_cap);
+		alloc.free(granules, num_granules*sizeof(Granule));
+		alloc.free(region_start, num_granules*sizeof(bool));
+	}
 
-		/**
-		 * Constructor
-		 */
-		Transfer(Transfer_space           &space,
-		         Cached_rom               &rom,
-		         File_system::Session     &fs,
-		         File_system::File_handle  file_handle,
-		         size_t                    file_size)
-		:
-			_cached_rom(rom), _fs(fs),
-			_handle(file_handle), _size(file_size),
-			_transfer_elem(*this, space, Transfer_space::Id{_handle.value})
-		{
-			_cached_rom.transfer = this;
+	bool completed() const { return num_present == num_granules; }
 
-			_submit_next_packet();
-		}
+	/**
+	 * Return true if the ROM may be evicted from the cache
+	 *
+	 * A ROM with an outstanding request is retained to prevent the
+	 * acknowledgement from being misattributed to a later file handle
+	 * with the same ID.
+	 */
+	bool unused() const { return (_ref_count < 1) && !in_flight; }
 
-		Path const &path() const { return _cached_rom.path; }
+	/**
+	 * Load the whole content in the background
+	 */
+	void start_prefetch()
+	{
+		prefetch = true;
+		_submit_next_request();
+	}
 
-		bool completed() const { return (_seek >= _size); }
+	/**
+	 * Issue pending read requests, called after acknowledgements freed
+	 * space in the packet buffer
+	 */
+	void schedule_io() { _submit_next_request(); }
 
-		/**
-		 * Called from the packet signal handler.
-		 */
-		void process_packet(File_system::Packet_descriptor const packet)
-		{
-			auto const pkt_seek = packet.position();
-
-			if (pkt_seek > _seek || _seek >= _size) {
-				error("bad packet seek position for ", path());
-				error("packet seek is ", packet.position(), ", file seek is ", _seek, ", file size is ", _size);
-				_seek = _size;
-			} else {
-				size_t const n = min(packet.length(), (size_t)(_size - pkt_seek));
-				memcpy(_cached_rom.ram_ds.local_addr<char>()+pkt_seek,
-				       _fs.tx()->packet_content(packet), n);
-				_seek = pkt_seek+n;
+	/**
+	 * Called from the packet signal handler for each acknowledged read
+	 */
+	void process_packet(File_system::Packet_descriptor const packet,
+	                    Cache_space &cache)
+	{
+		size_t const offset = load_first*GRANULE_SIZE;
+		size_t const length = min(load_count*GRANULE_SIZE, file_size - offset);
+
+		in_flight = false;
+
+		if (!packet.succeeded() || (size_t)packet.position() != offset
+		 || packet.length() < length) {
+
+			error(path, ": reading ", length, " bytes at ", offset, " failed");
+
+			/* leave the granules absent, demanded ones are requested again */
+			for (size_t i = load_first; i < load_first + load_count; i++)
+				granules[i] = Granule::ABSENT;
+
+			if (++read_errors < MAX_READ_ERRORS) {
+				_handle_fault();
+				_submit_next_request();
+				return;
 			}
 
-			if (completed())
-					_cached_rom.complete();
-			else
-				_submit_next_packet();
+			error(path, ": giving up after ", read_errors, " read errors");
+			_fail();
+			return;
+		}
+
+		memcpy(ram_ds->local_addr<char>() + offset,
+		       fs.tx()->packet_content(packet), length);
+
+		for (size_t i = load_first; i < load_first + load_count; i++)
+			granules[i] = Granule::PRESENT;
+
+		num_present += load_count;
+
+		if (completed()) {
+			_complete(cache);
+			return;
 		}
+
+		region_start[load_first] = true;
+		_attach(ram_ds->cap(), offset,
+		        min(load_count*GRANULE_SIZE, ds_size - offset));
+
+		/* serve faults that queued up behind the resolved one */
+		_handle_fault();
+	}
+
+	/**
+	 * Return dataspace with content of file
+	 */
+	Rom_dataspace_capability dataspace() const {
+		return static_cap_cast<Rom_dataspace>(rm_ds); }
 };
 
 
@@ -281,10 +560,12 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 {
 	Genode::Env &env;
 
+	Attached_rom_dataspace config { env, "config" };
+
 	Rm_connection rm { env };
 
 	Cache_space    cache     { };
-	Transfer_space transfers { };
+	Load_space     loads     { };
 	Session_space  sessions  { };
 
 	Heap heap { env.ram(), env.rm() };
@@ -297,6 +578,44 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 	Io_signal_handler<Main> packet_handler {
 		env.ep(), *this, &Main::handle_packets };
 
+	/*
+	 * Paths of the requested ROMs in the order of their first request
+	 *
+	 * The list is reported as "accesses" if enabled via the 'access_report'
+	 * config attribute. Fed back as "prefetch" ROM at the next start, it
+	 * allows for loading the ROMs ahead of the requests.
+	 */
+	struct Access : Fifo<Access>::Element
+	{
+		Path const path;
+
+		Access(Path const &path) : path(path) { }
+	};
+
+	Fifo<Access> accesses { };
+
+	Constructible<Expanding_reporter> access_reporter { };
+
+	void record_access(Path const &path)
+	{
+		if (!access_reporter.constructed())
+			return;
+
+		bool known = false;
+		accesses.for_each([&] (Access const &access) {
+			known |= (access.path == path); });
+
+		if (known)
+			return;
+
+		accesses.enqueue(*new (heap) Access(path));
+
+		access_reporter->generate([&] (Xml_generator &xml) {
+			accesses.for_each([&] (Access const &access) {
+				xml.node("rom", [&] {
+					xml.attribute("path", access.path.base()); }); }); });
+	}
+
 	/**
 	 * Return true when a cache element is freed
 	 */
@@ -312,33 +631,13 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 		return (bool)discard;
 	}
 
-	/**
-	 * Open a file handle
-	 */
-	File_system::File_handle open(Path const &file_path)
-	{
-		using namespace File_system;
-
-		Path dir_path(file_path);
-		dir_path.strip_last_element();
-		Path file_name(file_path);
-		file_name.keep_only_last_element();
-
-		Dir_handle parent_handle = fs.dir(dir_path.base(), false);
-		Handle_guard parent_guard(fs, parent_handle);
-
-		return fs.file(
-			parent_handle, file_name.base() + 1,
-			File_system::READ_ONLY, false);
-	}
-
 	/**
 	 * Open a file with some exception management
 	 */
 	File_system::File_handle try_open(Path const &file_path)
 	{
 		using namespace File_system;
-		try { return open(file_path); }
+		try { return open_file(fs, file_path); }
 		catch (Lookup_failed)     { error(file_path, " not found");          }
 		catch (Invalid_handle)    { error(file_path, ": invalid handle");    }
 		catch (Invalid_name)      { error(file_path, ": invalid nme");       }
@@ -347,6 +646,57 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 		throw Service_denied();
 	}
 
+	Cached_rom *lookup(Path const &path)
+	{
+		Cached_rom *rom = nullptr;
+		cache.for_each<Cached_rom&>([&] (Cached_rom &other) {
+			if (!rom && other.path == path && !other.failed)
+				rom = &other;
+		});
+		return rom;
+	}
+
+	/**
+	 * Create cache entry, the file content is populated on demand
+	 *
+	 * \param evict  drop unused cache entries to make room
+	 *
+	 * \throw Service_denied
+	 */
+	Cached_rom &create(Path const &path, bool evict)
+	{
+		File_system::File_handle const handle = try_open(path);
+
+		/* the entry opens the file again when loading its content */
+		File_system::file_size_t file_size = 0;
+		bool status_ok = true;
+		try { file_size = fs.status(handle).size; }
+		catch (...) { status_ok = false; }
+
+		fs.close(handle);
+
+		if (!status_ok)
+			throw Service_denied();
+
+		auto sufficient_resources = [&] {
+			return env.pd().avail_ram().value  > file_size + 64*1024
+			    && env.pd().avail_caps().value > 8; };
+
+		while (evict && !sufficient_resources())
+			if (!cache_evict()) break;
+
+		if (!sufficient_resources()) {
+			error(path, ": insufficient resources for caching");
+			throw Service_denied();
+		}
+
+		try {
+			return *new (heap) Cached_rom(cache, loads, env, heap, rm, fs,
+			                              path, (size_t)file_size);
+		}
+		catch (...) { throw Service_denied(); }
+	}
+
 	/**
 	 * Create new sessions
 	 */
@@ -379,47 +729,21 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 		Session_label const label = label_from_args(args.string());
 		Path          const path(label.last_element().string());
 
-		Cached_rom *rom = nullptr;
-
-		/* lookup the ROM in the cache */
-		cache.for_each<Cached_rom&>([&] (Cached_rom &other) {
-			if (!rom && other.path == path)
-				rom = &other;
-		});
-
-		if (!rom) {
-			File_system::File_handle handle = try_open(path);
-			File_system::Handle_guard guard(fs, handle);
-			File_system::file_size_t file_size = fs.status(handle).size;
-
-			while (env.pd().avail_ram().value < file_size || env.pd().avail_caps().value < 8) {
-				/* drop unused cache entries */
-				if (!cache_evict()) break;
-			}
-
-			rom = new (heap) Cached_rom(cache, env, rm, path, (size_t)file_size);
-		}
-
-		if (rom->completed()) {
-			/* Create new RPC object */
-			Session_component *session = new (heap)
-				Session_component(*rom, sessions, id, label);
-			if (session_diag_from_args(args.string()).enabled)
-				log("deliver ROM \"", label, "\"");
-			env.parent().deliver_session_cap(pid, env.ep().manage(*session));
+		Cached_rom *rom = lookup(path);
+		if (!rom)
+			rom = &create(path, true);
 
-		} else if (!rom->transfer) {
-			File_system::File_handle handle = try_open(path);
+		record_access(path);
 
-			try {
-				new (heap) Transfer(transfers, *rom, fs, handle, rom->file_size);
-			}
-			catch (...) {
-				fs.close(handle);
-				/* retry when next pending transfer completes */
-				return;
-			}
-		}
+		/*
+		 * Deliver the session right away, the content is populated when
+		 * the client touches it.
+		 */
+		Session_component *session = new (heap)
+			Session_component(*rom, sessions, id, label);
+		if (session_diag_from_args(args.string()).enabled)
+			log("deliver ROM \"", label, "\"");
+		env.parent().deliver_session_cap(pid, env.ep().manage(*session));
 	}
 
 	void handle_session_close(Parent::Server::Id pid) override
@@ -440,31 +764,58 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 
 		while (source.ack_avail()) {
 			File_system::Packet_descriptor pkt = source.get_acked_packet();
-			if (pkt.operation() != File_system::Packet_descriptor::READ) continue;
-
-			bool stray_pkt = true;
-
-			/* find the appropriate session */
-			transfers.apply<Transfer&>(
-				Transfer_space::Id{pkt.handle().value}, [&] (Transfer &transfer)
-			{
-				transfer.process_packet(pkt);
-				if (transfer.completed()) {
-					session_requests.schedule();
-					destroy(heap, &transfer);
-				}
-				stray_pkt = false;
-			});
-
-			if (stray_pkt)
-				source.release_packet(pkt);
+
+			if (pkt.operation() == File_system::Packet_descriptor::READ)
+				loads.apply<Cached_rom&>(
+					Load_space::Id{pkt.handle().value}, [&] (Cached_rom &rom) {
+						rom.process_packet(pkt, cache); });
+
+			source.release_packet(pkt);
+		}
+
+		/* use the freed packet-buffer space for pending requests */
+		cache.for_each<Cached_rom&>([&] (Cached_rom &rom) {
+			rom.schedule_io(); });
+	}
+
+	/**
+	 * Load the ROMs listed in the "prefetch" ROM in the background
+	 */
+	void prefetch()
+	{
+		Constructible<Attached_rom_dataspace> prefetch_rom { };
+
+		try { prefetch_rom.construct(env, "prefetch"); }
+		catch (Service_denied) {
+			warning("prefetching enabled but no \"prefetch\" ROM available");
+			return;
 		}
+
+		prefetch_rom->xml().for_each_sub_node("rom", [&] (Xml_node const &node) {
+
+			Path const path(node.attribute_value("path", String<File_system::MAX_PATH_LEN>()).string());
+
+			if (lookup(path))
+				return;
+
+			/* never evict cache entries for speculative loads */
+			try { create(path, false).start_prefetch(); }
+			catch (Service_denied) { }
+		});
 	}
 
 	Main(Genode::Env &env) : env(env)
 	{
 		fs.sigh(packet_handler);
 
+		Xml_node const config_xml = config.xml();
+
+		if (config_xml.attribute_value("access_report", false))
+			access_reporter.construct(env, "accesses", "accesses");
+
+		if (config_xml.attribute_value("prefetch", false))
+			prefetch();
+
 		/* process any requests that have already queued */
 		session_requests.schedule();
 	}
@@ -31,9 +31,15 @@ Arp_cache_entry::Arp_cache_entry(Ipv4_address const &ip,
 { }
 
 
-bool Arp_cache_entry::_higher(Ipv4_address const &ip) const
+size_t Arp_cache_entry::key_hash(Ipv4_address const &ip)
 {
-	return memcmp(ip.addr, _ip.addr, sizeof(_ip.addr)) > 0;
+	/* FNV-1a over the address bytes */
+	uint32_t result { 2166136261U };
+	for (uint8_t const byte : ip.addr) {
+		result ^= byte;
+		result *= 16777619U;
+	}
+	return result;
 }
 
 
@@ -47,14 +53,33 @@ void Arp_cache_entry::print(Output &output) const
  ** Arp_cache **
  ***************/
 
+Arp_cache::Arp_cache(Domain const &domain, Allocator &alloc)
+:
+	_domain(domain), _table(alloc)
+{ }
+
+
 void Arp_cache::new_entry(Ipv4_address const &ip, Mac_address const &mac)
 {
+	/*
+	 * The number of entries is bounded, so the table is allocated only once
+	 * on the first use. Without the table, addresses are not cached and
+	 * resolved again on demand.
+	 */
+	auto out_of_quota = [&] {
+		if (_domain.config().verbose()) {
+			log("[", _domain, "] out of quota while creating ARP entry"); }
+	};
+	try { _table.reserve(NR_OF_ENTRIES); }
+	catch (Out_of_ram)  { out_of_quota(); return; }
+	catch (Out_of_caps) { out_of_quota(); return; }
+
 	if (_entries[_curr].constructed()) {
-		remove(&(*_entries[_curr]));
+		_table.remove(*_entries[_curr]);
 	}
 	_entries[_curr].construct(ip, mac);
 	Arp_cache_entry &entry = *_entries[_curr];
-	insert(&entry);
+	_table.insert(entry);
 	if (_domain.config().verbose()) {
 		log("[", _domain, "] new ARP entry ", entry);
 	}
@@ -77,7 +102,7 @@ void Arp_cache::destroy_entries_with_mac(Mac_address const &mac)
 			if (_domain.config().verbose()) {
 				log("[", _domain, "] destroy ARP entry ", entry);
 			}
-			remove(&entry);
+			_table.remove(entry);
 			_entries[curr].destruct();
 		}
 	}
@@ -89,9 +114,7 @@ void Arp_cache::destroy_all_entries()
 	if (_domain.config().verbose()) {
 		log("[", _domain, "] destroy all ARP entries");
 	}
-	while (Arp_cache_entry *entry = first()) {
-		remove(entry);
-	}
+	_table.clear();
 	for (unsigned curr = 0; curr < NR_OF_ENTRIES; curr++) {
 		_entries[curr].destruct();
 	}
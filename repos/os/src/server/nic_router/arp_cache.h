@@ -17,9 +17,11 @@
 /* Genode includes */
 #include <net/ipv4.h>
 #include <net/ethernet.h>
-#include <util/avl_tree.h>
 #include <util/reconstructible.h>
 
+/* local includes */
+#include <hash_table.h>
+
 namespace Net {
 
 	class Domain;
@@ -29,48 +31,27 @@ namespace Net {
 }
 
 
-class Net::Arp_cache_entry : public Genode::Avl_node<Arp_cache_entry>
+class Net::Arp_cache_entry
 {
 	private:
 
 		Ipv4_address const _ip;
 		Mac_address  const _mac;
 
-		bool _higher(Ipv4_address const &ip) const;
-
 	public:
 
 		Arp_cache_entry(Ipv4_address const &ip, Mac_address const &mac);
 
-		void find_by_ip(Ipv4_address const &ip, auto const &handle_match, auto const &handle_no_match) const
-		{
-			if (ip != _ip) {
-
-				Arp_cache_entry *const entry_ptr {
-					Avl_node<Arp_cache_entry>::child(
-						_higher(ip)) };
-
-				if (entry_ptr != nullptr) {
-
-					entry_ptr->find_by_ip(
-						ip, handle_match, handle_no_match);
 
-				} else {
+		/****************
+		 ** Hash_table **
+		 ****************/
 
-					handle_no_match();
-				}
-			} else {
+		using Key = Ipv4_address;
 
-				handle_match(*this);
-			}
-		}
+		Key const &key() const { return _ip; }
 
-
-		/**************
-		 ** Avl_node **
-		 **************/
-
-		bool higher(Arp_cache_entry *entry) { return _higher(entry->_ip); }
+		static Genode::size_t key_hash(Key const &ip);
 
 
 		/***************
@@ -89,7 +70,7 @@ class Net::Arp_cache_entry : public Genode::Avl_node<Arp_cache_entry>
 };
 
 
-class Net::Arp_cache : public Genode::Avl_tree<Arp_cache_entry>
+class Net::Arp_cache
 {
 	private:
 
@@ -98,29 +79,21 @@ class Net::Arp_cache : public Genode::Avl_tree<Arp_cache_entry>
 			NR_OF_ENTRIES = ENTRIES_SIZE / sizeof(Arp_cache_entry),
 		};
 
-		Domain const         &_domain;
-		Arp_cache_entry_slot  _entries[NR_OF_ENTRIES];
-		unsigned              _curr = 0;
+		Domain const                &_domain;
+		Hash_table<Arp_cache_entry>  _table;
+		Arp_cache_entry_slot         _entries[NR_OF_ENTRIES];
+		unsigned                     _curr = 0;
 
 	public:
 
-		Arp_cache(Domain const &domain) : _domain(domain) { }
+		Arp_cache(Domain const &domain, Genode::Allocator &alloc);
 
 		void new_entry(Ipv4_address const &ip, Mac_address const &mac);
 
 		void destroy_entries_with_mac(Mac_address const &mac);
 
-		void find_by_ip(Ipv4_address const &ip, auto const &handle_match, auto const &handle_no_match) const
-		{
-			if (first() != nullptr) {
-
-				first()->find_by_ip(ip, handle_match, handle_no_match);
-
-			} else {
-
-				handle_no_match();
-			}
-		}
+		void find_by_ip(Ipv4_address const &ip, auto const &handle_match, auto const &handle_no_match) const {
+			_table.find(ip, handle_match, handle_no_match); }
 
 		void destroy_all_entries();
 };
@@ -0,0 +1,229 @@
+/*
+ * \brief  Resizable open-addressing hash table of object pointers
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The table references objects that provide the following interface:
+ *
+ *   'using Key = ...'                      type of the lookup key
+ *   'Key const &key() const'               the key of the object
+ *   'static size_t key_hash(Key const &)'  hash value of a key
+ *
+ * Collisions are resolved through linear probing. On removal, subsequent
+ * entries of the probe sequence are shifted backwards, so the table never
+ * contains tombstones and lookups stop at the first empty slot.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _HASH_TABLE_H_
+#define _HASH_TABLE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/string.h>
+
+namespace Net { template <typename> class Hash_table; }
+
+
+template <typename T>
+class Net::Hash_table
+{
+	private:
+
+		using size_t = Genode::size_t;
+		using Key    = typename T::Key;
+
+		enum { MIN_CAPACITY = 16 };
+
+		Genode::Allocator &_alloc;
+		T                **_slots    { nullptr };
+		size_t             _capacity { 0 };
+		size_t             _count    { 0 };
+
+		/*
+		 * Noncopyable
+		 */
+		Hash_table(Hash_table const &);
+		Hash_table &operator = (Hash_table const &);
+
+		size_t _mask() const { return _capacity - 1; }
+
+		size_t _home(Key const &key) const { return T::key_hash(key) & _mask(); }
+
+		/*
+		 * The table is kept at most three quarters full
+		 */
+		static bool _fits(size_t count, size_t capacity) {
+			return count * 4 <= capacity * 3; }
+
+		void _insert_unchecked(T &obj)
+		{
+			size_t idx { _home(obj.key()) };
+			while (_slots[idx])
+				idx = (idx + 1) & _mask();
+
+			_slots[idx] = &obj;
+		}
+
+		/**
+		 * Re-distribute all entries over a new slot array
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void _resize(size_t const capacity)
+		{
+			T **const slots { (T **)_alloc.alloc(capacity * sizeof(T *)) };
+			Genode::memset(slots, 0, capacity * sizeof(T *));
+
+			T    **const old_slots    { _slots };
+			size_t const old_capacity { _capacity };
+
+			_slots    = slots;
+			_capacity = capacity;
+			for (size_t idx = 0; idx < old_capacity; idx++)
+				if (old_slots[idx])
+					_insert_unchecked(*old_slots[idx]);
+
+			if (old_slots)
+				_alloc.free(old_slots, old_capacity * sizeof(T *));
+		}
+
+		void _remove_at(size_t hole)
+		{
+			_slots[hole] = nullptr;
+			_count--;
+
+			/*
+			 * Shift each subsequent entry of the probe sequence into the hole
+			 * if the hole lies between the entry's home slot and its current
+			 * slot.
+			 */
+			for (size_t idx = (hole + 1) & _mask(); _slots[idx];
+			     idx = (idx + 1) & _mask())
+			{
+				size_t const home { _home(_slots[idx]->key()) };
+				if (((idx - home) & _mask()) < ((idx - hole) & _mask()))
+					continue;
+
+				_slots[hole] = _slots[idx];
+				_slots[idx]  = nullptr;
+				hole         = idx;
+			}
+		}
+
+	public:
+
+		Hash_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Hash_table()
+		{
+			if (_slots)
+				_alloc.free(_slots, _capacity * sizeof(T *));
+		}
+
+		/**
+		 * Ensure that 'count' entries fit without further allocation
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void reserve(size_t const count)
+		{
+			size_t capacity { _capacity ? _capacity : (size_t)MIN_CAPACITY };
+			while (!_fits(count, capacity))
+				capacity <<= 1;
+
+			if (capacity != _capacity)
+				_resize(capacity);
+		}
+
+		/**
+		 * Insert object, the key of the object must not be present yet
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void insert(T &obj)
+		{
+			reserve(_count + 1);
+			_insert_unchecked(obj);
+			_count++;
+		}
+
+		/**
+		 * Remove object, do nothing if the object is not present
+		 */
+		void remove(T &obj)
+		{
+			if (!_count)
+				return;
+
+			for (size_t idx = _home(obj.key()); _slots[idx];
+			     idx = (idx + 1) & _mask())
+			{
+				if (_slots[idx] == &obj) {
+					_remove_at(idx);
+					return;
+				}
+			}
+		}
+
+		void find(Key const &key, auto const &handle_match, auto const &handle_no_match) const
+		{
+			if (_count) {
+				for (size_t idx = _home(key); _slots[idx];
+				     idx = (idx + 1) & _mask())
+				{
+					if (_slots[idx]->key() == key) {
+						handle_match(*_slots[idx]);
+						return;
+					}
+				}
+			}
+			handle_no_match();
+		}
+
+		void for_each(auto const &fn) const
+		{
+			for (size_t idx = 0; idx < _capacity; idx++)
+				if (_slots[idx])
+					fn(*_slots[idx]);
+		}
+
+		/**
+		 * Call 'fn' for each object, 'fn' must remove the object
+		 */
+		void drain(auto const &fn)
+		{
+			/*
+			 * As backward shifting never moves entries into slots that were
+			 * already drained, a single pass over the slots is sufficient.
+			 */
+			for (size_t idx = 0; idx < _capacity; idx++)
+				while (_slots[idx])
+					fn(*_slots[idx]);
+		}
+
+		/**
+		 * Remove all objects without destructing them
+		 */
+		void clear()
+		{
+			if (_slots)
+				Genode::memset(_slots, 0, _capacity * sizeof(T *));
+
+			_count = 0;
+		}
+
+		size_t count()    const { return _count; }
+		size_t capacity() const { return _capacity; }
+};
+
+#endif /* _HASH_TABLE_H_ */
@@ -33,6 +33,7 @@ using Genode::uint32_t;
 using Genode::addr_t;
 using Genode::log;
 using Genode::error;
+using Genode::warning;
 using Genode::Exception;
 using Genode::Out_of_ram;
 using Genode::Out_of_caps;
@@ -166,8 +167,7 @@ static void _update_checksum(L3_protocol   const prot,
                              void         *const prot_base,
                              size_t        const prot_size,
                              Ipv4_address  const src,
-                             Ipv4_address  const dst,
-                             size_t        const ip_size)
+                             Ipv4_address  const dst)
 {
 	switch (prot) {
 	case L3_protocol::TCP:
@@ -177,16 +177,26 @@ static void _update_checksum(L3_protocol   const prot,
 		((Udp_packet *)prot_base)->update_checksum(src, dst);
 		return;
 	case L3_protocol::ICMP:
-		{
-			Icmp_packet &icmp = *(Icmp_packet *)prot_base;
-			icmp.update_checksum(ip_size - sizeof(Ipv4_packet) -
-			                               sizeof(Icmp_packet));
-			return;
-		}
+		/* the checksum is kept up to date by '_query_id' */
+		return;
 	default: ASSERT_NEVER_REACHED; }
 }
 
 
+/**
+ * Set the ICMP query ID and update the checksum incrementally
+ *
+ * The ICMP checksum doesn't cover a pseudo header and was verified on
+ * reception, so the diff of the ID is all that must be applied.
+ */
+static void _query_id(Icmp_packet &icmp, Genode::uint16_t const id)
+{
+	Internet_checksum_diff icd { };
+	icmp.query_id(id, icd);
+	icmp.update_checksum(icd);
+}
+
+
 static Port _dst_port(L3_protocol const prot, void *const prot_base)
 {
 	switch (prot) {
@@ -204,7 +214,7 @@ static void _dst_port(L3_protocol  const prot,
 	switch (prot) {
 	case L3_protocol::TCP:  (*(Tcp_packet *)prot_base).dst_port(port);  return;
 	case L3_protocol::UDP:  (*(Udp_packet *)prot_base).dst_port(port);  return;
-	case L3_protocol::ICMP: (*(Icmp_packet *)prot_base).query_id(port.value); return;
+	case L3_protocol::ICMP: _query_id(*(Icmp_packet *)prot_base, port.value); return;
 	default: ASSERT_NEVER_REACHED; }
 }
 
@@ -226,7 +236,7 @@ static void _src_port(L3_protocol  const prot,
 	switch (prot) {
 	case L3_protocol::TCP:  ((Tcp_packet *)prot_base)->src_port(port);        return;
 	case L3_protocol::UDP:  ((Udp_packet *)prot_base)->src_port(port);        return;
-	case L3_protocol::ICMP: ((Icmp_packet *)prot_base)->query_id(port.value); return;
+	case L3_protocol::ICMP: _query_id(*(Icmp_packet *)prot_base, port.value); return;
 	default: ASSERT_NEVER_REACHED; }
 }
 
@@ -336,8 +346,7 @@ void Interface::_pass_prot_to_domain(Domain                       &domain,
                                      void                  *const  prot_base,
                                      size_t                 const  prot_size)
 {
-	_update_checksum(
-		prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
+	_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst());
 
 	ip.update_checksum(ip_icd);
 	domain.interfaces().for_each([&] (Interface &interface)
@@ -508,6 +517,19 @@ void Interface::_try_emergency_free_quota()
 }
 
 
+void Interface::_reserve_link_sides(L3_protocol const  protocol,
+                                    Domain            &local_domain,
+                                    Domain            &remote_domain)
+{
+	/*
+	 * Reserve for both link sides at both domains as the domains may be the
+	 * same. This way, constructing the link can't fail while inserting.
+	 */
+	local_domain.links(protocol).reserve_additional(2);
+	remote_domain.links(protocol).reserve_additional(2);
+}
+
+
 Packet_result Interface::_new_link(L3_protocol          const  protocol,
                                    void                *const  prot_base,
                                    Domain                     &local_domain,
@@ -521,9 +543,10 @@ Packet_result Interface::_new_link(L3_protocol          const  protocol,
 	case L3_protocol::TCP:
 		retry_once<Out_of_ram, Out_of_caps>(
 			[&] {
+				_reserve_link_sides(protocol, local_domain, remote_domain);
 				new (_alloc)
 					Tcp_link { *this, local_domain, local, remote_port_alloc_ptr, remote_domain,
-					           remote, _timer, *_config_ptr, protocol, _tcp_stats, *(Tcp_packet *)prot_base }; },
+					           remote, _link_timeouts, *_config_ptr, protocol, _tcp_stats, *(Tcp_packet *)prot_base }; },
 			[&] { _try_emergency_free_quota(); },
 			[&] {
 				_tcp_stats.refused_for_ram++;
@@ -532,9 +555,10 @@ Packet_result Interface::_new_link(L3_protocol          const  protocol,
 	case L3_protocol::UDP:
 		retry_once<Out_of_ram, Out_of_caps>(
 			[&] {
+				_reserve_link_sides(protocol, local_domain, remote_domain);
 				new (_alloc)
 					Udp_link { *this, local_domain, local, remote_port_alloc_ptr, remote_domain,
-					           remote, _timer, *_config_ptr, protocol, _udp_stats }; },
+					           remote, _link_timeouts, *_config_ptr, protocol, _udp_stats }; },
 			[&] { _try_emergency_free_quota(); },
 			[&] {
 				_udp_stats.refused_for_ram++;
@@ -543,9 +567,10 @@ Packet_result Interface::_new_link(L3_protocol          const  protocol,
 	case L3_protocol::ICMP:
 		retry_once<Out_of_ram, Out_of_caps>(
 			[&] {
+				_reserve_link_sides(protocol, local_domain, remote_domain);
 				new (_alloc)
 					Icmp_link { *this, local_domain, local, remote_port_alloc_ptr, remote_domain,
-					            remote, _timer, *_config_ptr, protocol, _icmp_stats }; },
+					            remote, _link_timeouts, *_config_ptr, protocol, _icmp_stats }; },
 			[&] { _try_emergency_free_quota(); },
 			[&] {
 				_icmp_stats.refused_for_ram++;
@@ -1639,9 +1664,8 @@ void Interface::_drop_packet(Packet_descriptor const &pkt, char const *reason)
 }
 
 
-void Interface::_handle_pkt()
+void Interface::_handle_pkt(Packet_descriptor const &pkt)
 {
-	Packet_descriptor const pkt = _sink.get_packet();
 	if (!_sink.packet_valid(pkt) || pkt.size() < sizeof(Packet_stream_sink::Content_type)) {
 		_drop_packet(pkt, "invalid Nic packet");
 		return;
@@ -1656,6 +1680,38 @@ void Interface::_handle_pkt()
 }
 
 
+void Interface::_collect_garbage(Domain &local_domain)
+{
+	/* do garbage collection over transport-layer links and DHCP allocations */
+	_destroy_dissolved_links<Icmp_link>(_dissolved_icmp_links, _alloc);
+	_destroy_dissolved_links<Udp_link>(_dissolved_udp_links, _alloc);
+	_destroy_dissolved_links<Tcp_link>(_dissolved_tcp_links, _alloc);
+	_destroy_timed_out_arp_waiters();
+	_destroy_released_dhcp_allocations(local_domain);
+}
+
+
+unsigned long Interface::_handle_pkt_burst(unsigned long const max_pkts)
+{
+	/*
+	 * Dequeue a burst of packets at once so that the per-packet work is
+	 * reduced to classifying and forwarding. Book-keeping that doesn't
+	 * depend on the individual packet is done only once per burst.
+	 */
+	Packet_descriptor pkts[PKT_BURST_SIZE];
+	unsigned long nr_of_pkts { 0 };
+	while (nr_of_pkts < max_pkts && _sink.packet_avail())
+		pkts[nr_of_pkts++] = _sink.get_packet();
+
+	with_domain([&] (Domain &domain) { _collect_garbage(domain); });
+
+	for (unsigned long idx = 0; idx < nr_of_pkts; idx++)
+		_handle_pkt(pkts[idx]);
+
+	return nr_of_pkts;
+}
+
+
 void Interface::_handle_pkt_stream_signal()
 {
 	_timer.update_cached_time();
@@ -1670,30 +1726,28 @@ void Interface::_handle_pkt_stream_signal()
 	}
 
 	/*
-	 * Handle packets received from the counter side. If the user configured
-	 * a limit for the number of packets to be handled at once, this limit gets
-	 * applied. If there is no such limit, received packets are handled until
-	 * none is left.
+	 * Handle packets received from the counter side in bursts. If the user
+	 * configured a limit for the number of packets to be handled at once,
+	 * this limit gets applied. If there is no such limit, received packets
+	 * are handled until none is left.
 	 */
 	unsigned long const max_pkts = _config_ptr->max_packets_per_signal();
-	if (max_pkts) {
-		for (unsigned long i = 0; _sink.packet_avail(); i++) {
+	for (unsigned long nr_of_pkts = 0; _sink.packet_avail(); ) {
 
-			if (i >= max_pkts) {
+		if (max_pkts && nr_of_pkts >= max_pkts) {
 
-				/*
-				 * Ensure that this handler is called again in order to handle
-				 * the packets left unhandled due to the configured limit.
-				 */
-				Signal_transmitter(_pkt_stream_signal_handler).submit();
-				break;
-			}
-			_handle_pkt();
-		}
-	} else {
-		while (_sink.packet_avail()) {
-			_handle_pkt();
+			/*
+			 * Ensure that this handler is called again in order to handle
+			 * the packets left unhandled due to the configured limit.
+			 */
+			Signal_transmitter(_pkt_stream_signal_handler).submit();
+			break;
 		}
+		unsigned long burst_size { PKT_BURST_SIZE };
+		if (max_pkts && max_pkts - nr_of_pkts < burst_size)
+			burst_size = max_pkts - nr_of_pkts;
+
+		nr_of_pkts += _handle_pkt_burst(burst_size);
 	}
 
 	/*
@@ -1830,13 +1884,6 @@ Packet_result Interface::_handle_eth(void              *const  eth_base,
 
 			domain.raise_rx_bytes(size_guard.total_size());
 
-			/* do garbage collection over transport-layer links and DHCP allocations */
-			_destroy_dissolved_links<Icmp_link>(_dissolved_icmp_links, _alloc);
-			_destroy_dissolved_links<Udp_link>(_dissolved_udp_links, _alloc);
-			_destroy_dissolved_links<Tcp_link>(_dissolved_tcp_links, _alloc);
-			_destroy_timed_out_arp_waiters();
-			_destroy_released_dhcp_allocations(domain);
-
 			/* log received packet if desired */
 			if (domain.verbose_packets()) {
 				log("[", domain, "] rcv ", eth); }
@@ -1941,6 +1988,18 @@ bool Interface::_try_update_link(Link        &link,
 	    old_srv_dom.ip_config() != new_srv_dom.ip_config())
 		return false;
 
+	/*
+	 * The link sides were reserved by '_reserve_link_sides_for_update'
+	 * already. Only if that failed even after freeing quota, we get here
+	 * without the table slots needed for moving the link.
+	 */
+	try {
+		cln_dom.links(prot).reserve_additional(&cln_dom == &new_srv_dom ? 2 : 1);
+		new_srv_dom.links(prot).reserve_additional(1);
+	}
+	catch (Out_of_ram)  { warning("[", cln_dom, "] out of quota while updating link"); return false; }
+	catch (Out_of_caps) { warning("[", cln_dom, "] out of quota while updating link"); return false; }
+
 	if (link.client().src_ip() == link.server().dst_ip()) {
 		link.handle_config(cln_dom, new_srv_dom, nullptr, *_config_ptr);
 		return true;
@@ -1966,6 +2025,28 @@ bool Interface::_try_update_link(Link        &link,
 }
 
 
+void Interface::_reserve_link_sides_for_update(L3_protocol  prot,
+                                               Domain      &cln_dom)
+{
+	/*
+	 * The client side of each link moves to the client domain and the
+	 * server side to the new domain of the same name as the old server
+	 * domain.
+	 */
+	_config_ptr->domains().for_each([&] (Domain &domain) {
+		size_t nr_of_sides { 0 };
+		links(prot).for_each([&] (Link &link) {
+			if (&domain == &cln_dom)
+				nr_of_sides++;
+			if (link.server().domain().name() == domain.name())
+				nr_of_sides++;
+		});
+		if (nr_of_sides)
+			domain.links(prot).reserve_additional(nr_of_sides);
+	});
+}
+
+
 void Interface::_update_udp_tcp_links(L3_protocol  prot,
                                       Domain      &cln_dom)
 {
@@ -2265,6 +2346,20 @@ void Interface::handle_config_3()
 		if (!new_domain.ip_config().valid()) {
 			return;
 		}
+		/*
+		 * Reserve the link-side slots at the new domains up front, as links
+		 * can't be dropped to free quota while updating them
+		 */
+		auto reserve_link_sides = [&] (L3_protocol prot) {
+			retry_once<Out_of_ram, Out_of_caps>(
+				[&] { _reserve_link_sides_for_update(prot, new_domain); },
+				[&] { _try_emergency_free_quota(); },
+				[&] { }); };
+
+		reserve_link_sides(L3_protocol::TCP);
+		reserve_link_sides(L3_protocol::UDP);
+		reserve_link_sides(L3_protocol::ICMP);
+
 		/* update state objects */
 		_update_udp_tcp_links(L3_protocol::TCP, new_domain);
 		_update_udp_tcp_links(L3_protocol::UDP, new_domain);
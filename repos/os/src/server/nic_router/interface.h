@@ -129,6 +129,8 @@ class Net::Interface : private Interface_list::Element
 
 		enum { IPV4_TIME_TO_LIVE          = 64 };
 		enum { MAX_FREE_OPS_PER_EMERGENCY = 100 };
+		enum { PKT_BURST_SIZE             = 32 };
+		enum { LINK_TIMEOUT_TICK_US       = 100 * 1000 };
 
 		struct Update_domain
 		{
@@ -152,6 +154,7 @@ class Net::Interface : private Interface_list::Element
 		Interface_policy                     &_policy;
 		Cached_timer                         &_timer;
 		Genode::Allocator                    &_alloc;
+		Timeout_wheel                         _link_timeouts             { _timer, Genode::Microseconds { LINK_TIMEOUT_TICK_US } };
 		Domain                               *_domain_ptr                { };
 		Arp_waiter_list                       _own_arp_waiters           { };
 		Arp_waiter_list                       _timed_out_arp_waiters     { };
@@ -187,6 +190,10 @@ class Net::Interface : private Interface_list::Element
 		                                     Domain                     &remote_domain,
 		                                     Link_side_id         const &remote_id);
 
+		void _reserve_link_sides(L3_protocol const  protocol,
+		                         Domain            &local_domain,
+		                         Domain            &remote_domain);
+
 		void _destroy_released_dhcp_allocations(Domain &local_domain);
 
 		void _destroy_dhcp_allocation(Dhcp_allocation &allocation,
@@ -308,7 +315,11 @@ class Net::Interface : private Interface_list::Element
 		                          void                  *const  prot_base,
 		                          Genode::size_t         const  prot_size);
 
-		void _handle_pkt();
+		void _handle_pkt(Packet_descriptor const &pkt);
+
+		unsigned long _handle_pkt_burst(unsigned long max_pkts);
+
+		void _collect_garbage(Domain &local_domain);
 
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
@@ -341,6 +352,9 @@ class Net::Interface : private Interface_list::Element
 
 		void _update_icmp_links(Domain &cln_dom);
 
+		void _reserve_link_sides_for_update(L3_protocol  prot,
+		                                    Domain      &cln_dom);
+
 		bool _try_update_link(Link        &link,
 		                      Domain      &new_srv_dom,
 		                      L3_protocol  prot,
@@ -33,15 +33,28 @@ constexpr size_t Link_side_id::data_size()
 }
 
 
-bool Link_side_id::operator != (Link_side_id const &id) const
+size_t Link_side_id::hash() const
 {
-	return memcmp(id.data_base(), data_base(), data_size()) != 0;
+	/* FNV-1a over the packed 4-tuple */
+	uint8_t const *const bytes { (uint8_t const *)data_base() };
+	uint32_t result { 2166136261U };
+	for (size_t idx = 0; idx < data_size(); idx++) {
+		result ^= bytes[idx];
+		result *= 16777619U;
+	}
+	return result;
+}
+
+
+bool Link_side_id::operator == (Link_side_id const &id) const
+{
+	return memcmp(id.data_base(), data_base(), data_size()) == 0;
 }
 
 
-bool Link_side_id::operator > (Link_side_id const &id) const
+bool Link_side_id::operator != (Link_side_id const &id) const
 {
-	return memcmp(id.data_base(), data_base(), data_size()) > 0;
+	return memcmp(id.data_base(), data_base(), data_size()) != 0;
 }
 
 
@@ -91,7 +104,7 @@ Link::Link(Interface                     &cln_interface,
            Port_allocator_guard          *srv_port_alloc_ptr,
            Domain                        &srv_domain,
            Link_side_id            const &srv_id,
-           Cached_timer                  &timer,
+           Timeout_wheel                 &timeouts,
            Configuration                 &config,
            L3_protocol             const  protocol,
            Microseconds            const  dissolve_timeout,
@@ -100,8 +113,7 @@ Link::Link(Interface                     &cln_interface,
 	_config_ptr(&config),
 	_client_interface(cln_interface),
 	_server_port_alloc_ptr(srv_port_alloc_ptr),
-	_dissolve_timeout(timer, *this, &Link::_handle_dissolve_timeout,
-	                  Microseconds { 100 * 1000 }),
+	_dissolve_timeout(timeouts, *this, &Link::_handle_dissolve_timeout),
 	_dissolve_timeout_us(dissolve_timeout),
 	_protocol(protocol),
 	_client(cln_domain, cln_id, *this),
@@ -110,9 +122,11 @@ Link::Link(Interface                     &cln_interface,
 	_stats_ptr(&stats.opening)
 {
 	(*_stats_ptr)++;
+
+	/* the creator of the link has reserved the slots for both link sides */
 	_client_interface.links(_protocol).insert(this);
-	_client.domain().links(_protocol).insert(&_client);
-	_server.domain().links(_protocol).insert(&_server);
+	_client.domain().links(_protocol).insert(_client);
+	_server.domain().links(_protocol).insert(_server);
 	_dissolve_timeout.schedule(_dissolve_timeout_us);
 }
 
@@ -142,8 +156,8 @@ void Link::dissolve(bool timeout)
 	}
 	(*_stats_ptr)++;
 
-	_client.domain().links(_protocol).remove(&_client);
-	_server.domain().links(_protocol).remove(&_server);
+	_client.domain().links(_protocol).remove(_client);
+	_server.domain().links(_protocol).remove(_server);
 	if (_config_ptr->verbose()) {
 		log("Dissolve ", l3_protocol_name(_protocol), " link: ", *this); }
 
@@ -174,16 +188,16 @@ void Link::handle_config(Domain               &cln_domain,
 	_dissolve_timeout_us = dissolve_timeout_us;
 	_dissolve_timeout.schedule(_dissolve_timeout_us);
 
-	_client.domain().links(_protocol).remove(&_client);
-	_server.domain().links(_protocol).remove(&_server);
+	_client.domain().links(_protocol).remove(_client);
+	_server.domain().links(_protocol).remove(_server);
 
 	_config_ptr = &config;
 	_client._domain_ptr = &cln_domain;
 	_server._domain_ptr = &srv_domain;
 	_server_port_alloc_ptr = srv_port_alloc_ptr;
 
-	cln_domain.links(_protocol).insert(&_client);
-	srv_domain.links(_protocol).insert(&_server);
+	cln_domain.links(_protocol).insert(_client);
+	srv_domain.links(_protocol).insert(_server);
 
 	if (config.verbose()) {
 		log("[", cln_domain, "] update link client: ", _client);
@@ -202,13 +216,13 @@ Tcp_link::Tcp_link(Interface                  &cln_interface,
                    Port_allocator_guard       *srv_port_alloc_ptr,
                    Domain                     &srv_domain,
                    Link_side_id         const &srv_id,
-                   Cached_timer               &timer,
+                   Timeout_wheel              &timeouts,
                    Configuration              &config,
                    L3_protocol          const  protocol,
                    Interface_link_stats       &stats,
                    Tcp_packet                 &tcp)
 :
-	Link(cln_interface, cln_domain, cln_id, srv_port_alloc_ptr, srv_domain, srv_id, timer,
+	Link(cln_interface, cln_domain, cln_id, srv_port_alloc_ptr, srv_domain, srv_id, timeouts,
 	     config, protocol, config.tcp_idle_timeout(), stats)
 {
 	client_packet(tcp);
@@ -294,12 +308,12 @@ Udp_link::Udp_link(Interface                  &cln_interface,
                    Port_allocator_guard       *srv_port_alloc_ptr,
                    Domain                     &srv_domain,
                    Link_side_id         const &srv_id,
-                   Cached_timer               &timer,
+                   Timeout_wheel              &timeouts,
                    Configuration              &config,
                    L3_protocol          const  protocol,
                    Interface_link_stats       &stats)
 :
-	Link(cln_interface, cln_domain, cln_id, srv_port_alloc_ptr, srv_domain, srv_id, timer,
+	Link(cln_interface, cln_domain, cln_id, srv_port_alloc_ptr, srv_domain, srv_id, timeouts,
 	     config, protocol, config.udp_idle_timeout(), stats)
 { }
 
@@ -326,12 +340,12 @@ Icmp_link::Icmp_link(Interface                  &cln_interface,
                      Port_allocator_guard       *srv_port_alloc_ptr,
                      Domain                     &srv_domain,
                      Link_side_id         const &srv_id,
-                     Cached_timer               &timer,
+                     Timeout_wheel              &timeouts,
                      Configuration              &config,
                      L3_protocol          const  protocol,
                      Interface_link_stats       &stats)
 :
-	Link(cln_interface, cln_domain, cln_id, srv_port_alloc_ptr, srv_domain, srv_id, timer,
+	Link(cln_interface, cln_domain, cln_id, srv_port_alloc_ptr, srv_domain, srv_id, timeouts,
 	     config, protocol, config.icmp_idle_timeout(), stats)
 { }
 
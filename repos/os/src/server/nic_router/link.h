@@ -31,7 +31,6 @@
 #define _LINK_H_
 
 /* Genode includes */
-#include <util/avl_tree.h>
 #include <util/list.h>
 #include <net/ipv4.h>
 #include <net/port.h>
@@ -39,7 +38,8 @@
 /* local includes */
 #include <list.h>
 #include <l3_protocol.h>
-#include <lazy_one_shot_timeout.h>
+#include <hash_table.h>
+#include <timeout_wheel.h>
 
 namespace Net {
 
@@ -51,7 +51,7 @@ namespace Net {
 	class  Interface;
 	class  Link_side_id;
 	class  Link_side;
-	class  Link_side_tree;
+	class  Link_side_table;
 	class  Link;
 	struct Link_list : List<Link> { };
 	class  Tcp_link;
@@ -71,19 +71,21 @@ struct Net::Link_side_id
 
 	void *data_base() const { return (void *)&src_ip; }
 
+	Genode::size_t hash() const;
+
 
 	/************************
 	 ** Standard operators **
 	 ************************/
 
-	bool operator != (Link_side_id const &id) const;
+	bool operator == (Link_side_id const &id) const;
 
-	bool operator > (Link_side_id const &id) const;
+	bool operator != (Link_side_id const &id) const;
 }
 __attribute__((__packed__));
 
 
-class Net::Link_side : public Genode::Avl_node<Link_side>
+class Net::Link_side
 {
 	friend class Link;
 
@@ -105,37 +107,18 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		          Link_side_id const &id,
 		          Link               &link);
 
-		void find_by_id(Link_side_id const &id, auto const &handle_match, auto const &handle_no_match) const
-		{
-			if (id != _id) {
-
-				Link_side *const link_side_ptr {
-					Avl_node<Link_side>::child(id > _id) };
-
-				if (link_side_ptr != nullptr) {
-
-					link_side_ptr->find_by_id(
-						id, handle_match, handle_no_match);
-
-				} else {
-
-					handle_no_match();
-				}
-
-			} else {
+		bool is_client() const;
 
-				handle_match(*this);
-			}
-		}
 
-		bool is_client() const;
+		/****************
+		 ** Hash_table **
+		 ****************/
 
+		using Key = Link_side_id;
 
-		/**************
-		 ** Avl_node **
-		 **************/
+		Key const &key() const { return _id; }
 
-		bool higher(Link_side *side) { return side->_id > _id; }
+		static Genode::size_t key_hash(Key const &id) { return id.hash(); }
 
 
 		/*********
@@ -151,6 +134,7 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 
 		Domain             &domain()    const { return *_domain_ptr; }
 		Link               &link()      const { return _link; }
+		Link_side_id const &id()        const { return _id; }
 		Ipv4_address const &src_ip()    const { return _id.src_ip; }
 		Ipv4_address const &dst_ip()    const { return _id.dst_ip; }
 		Port                src_port()  const { return _id.src_port; }
@@ -158,19 +142,21 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 };
 
 
-struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
+struct Net::Link_side_table : Hash_table<Link_side>
 {
-	void find_by_id(Link_side_id const &id, auto const &handle_match, auto const &handle_no_match) const
-	{
-		if (first() != nullptr) {
-
-			first()->find_by_id(id, handle_match, handle_no_match);
-
-		} else {
-
-			handle_no_match();
-		}
-	}
+	Link_side_table(Genode::Allocator &alloc) : Hash_table<Link_side>(alloc) { }
+
+	/**
+	 * Ensure that 'nr_of_sides' more link sides fit without allocation
+	 *
+	 * \throw Out_of_ram
+	 * \throw Out_of_caps
+	 */
+	void reserve_additional(Genode::size_t nr_of_sides) {
+		reserve(count() + nr_of_sides); }
+
+	void find_by_id(Link_side_id const &id, auto const &handle_match, auto const &handle_no_match) const {
+		find(id, handle_match, handle_no_match); }
 };
 
 
@@ -181,7 +167,7 @@ class Net::Link : public Link_list::Element
 		Configuration                 *_config_ptr;
 		Interface                     &_client_interface;
 		Port_allocator_guard          *_server_port_alloc_ptr;
-		Lazy_one_shot_timeout<Link>    _dissolve_timeout;
+		Wheel_timeout<Link>            _dissolve_timeout;
 		Genode::Microseconds           _dissolve_timeout_us;
 		L3_protocol             const  _protocol;
 		Link_side                      _client;
@@ -210,7 +196,7 @@ class Net::Link : public Link_list::Element
 		     Port_allocator_guard       *srv_port_alloc_ptr,
 		     Domain                     &srv_domain,
 		     Link_side_id         const &srv_id,
-		     Cached_timer               &timer,
+		     Timeout_wheel              &timeouts,
 		     Configuration              &config,
 		     L3_protocol          const  protocol,
 		     Genode::Microseconds const  dissolve_timeout,
@@ -284,7 +270,7 @@ class Net::Tcp_link : public Link
 		         Port_allocator_guard      *srv_port_alloc_ptr,
 		         Domain                    &srv_domain,
 		         Link_side_id        const &srv_id,
-		         Cached_timer              &timer,
+		         Timeout_wheel             &timeouts,
 		         Configuration             &config,
 		         L3_protocol         const  protocol,
 		         Interface_link_stats      &stats,
@@ -306,7 +292,7 @@ struct Net::Udp_link : Link
 	         Port_allocator_guard          *srv_port_alloc_ptr,
 	         Domain                        &srv_domain,
 	         Link_side_id            const &srv_id,
-	         Cached_timer                  &timer,
+	         Timeout_wheel                 &timeouts,
 	         Configuration                 &config,
 	         L3_protocol             const  protocol,
 	         Interface_link_stats          &stats);
@@ -327,7 +313,7 @@ struct Net::Icmp_link : Link
 	          Port_allocator_guard       *srv_port_alloc_ptr,
 	          Domain                     &srv_domain,
 	          Link_side_id         const &srv_id,
-	          Cached_timer               &timer,
+	          Timeout_wheel              &timeouts,
 	          Configuration              &config,
 	          L3_protocol          const  protocol,
 	          Interface_link_stats       &stats);
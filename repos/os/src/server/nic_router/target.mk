@@ -27,6 +27,7 @@ SRC_CC += \
 	xml_node.cc \
 	uplink_session_root.cc \
 	communication_buffer.cc \
+	timeout_wheel.cc \
 
 INC_DIR += $(PRG_DIR)
 
@@ -0,0 +1,177 @@
+/*
+ * \brief  Hashed timer wheel for large numbers of coarse-grained timeouts
+ * \author agent
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <timeout_wheel.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+/*************************
+ ** Timeout_wheel::Slot **
+ *************************/
+
+void Timeout_wheel::Slot::insert(Timeout &timeout)
+{
+	timeout._prev     = nullptr;
+	timeout._next     = first;
+	timeout._slot_ptr = this;
+	if (first)
+		first->_prev = &timeout;
+
+	first = &timeout;
+}
+
+
+void Timeout_wheel::Slot::remove(Timeout &timeout)
+{
+	if (timeout._prev)
+		timeout._prev->_next = timeout._next;
+	else
+		first = timeout._next;
+
+	if (timeout._next)
+		timeout._next->_prev = timeout._prev;
+
+	timeout._prev     = nullptr;
+	timeout._next     = nullptr;
+	timeout._slot_ptr = nullptr;
+}
+
+
+/*******************
+ ** Timeout_wheel **
+ *******************/
+
+Timeout_wheel::Timeout_wheel(Cached_timer &timer, Microseconds tick)
+:
+	_timer   { timer },
+	_tick_us { tick.value ? tick.value : 1 },
+	_timeout { timer, *this, &Timeout_wheel::_handle_timeout }
+{ }
+
+
+Timeout_wheel::~Timeout_wheel() { _timeout.discard(); }
+
+
+void Timeout_wheel::_insert(Timeout &timeout)
+{
+	/* round up to the next tick and never insert into a passed slot */
+	uint64_t tick { timeout._deadline_us / _tick_us +
+	                (timeout._deadline_us % _tick_us ? 1 : 0) };
+	if (tick < _next_tick)
+		tick = _next_tick;
+
+	_slot(tick).insert(timeout);
+
+	if (!_timeout.scheduled() || tick < _scheduled_tick)
+		_schedule_tick(tick);
+}
+
+
+void Timeout_wheel::_schedule_tick(uint64_t tick)
+{
+	uint64_t const curr_us { _curr_us() };
+	uint64_t const tick_us { tick * _tick_us };
+	_timeout.schedule(Microseconds { tick_us > curr_us ? tick_us - curr_us : 0 });
+	_scheduled_tick = tick;
+}
+
+
+void Timeout_wheel::_handle_timeout(Duration curr_time)
+{
+	_timer.cached_time(curr_time);
+
+	uint64_t const curr_us   { _curr_us() };
+	uint64_t const curr_tick { curr_us / _tick_us };
+
+	for (unsigned nr = 0; nr < NR_OF_SLOTS && _next_tick <= curr_tick; nr++) {
+
+		/*
+		 * Detach the slot and advance the wheel before calling any handler,
+		 * so timeouts scheduled by a handler end up in an upcoming slot.
+		 */
+		Slot &slot { _slot(_next_tick) };
+		Slot  pending { };
+		while (Timeout *timeout = slot.first) {
+			slot.remove(*timeout);
+			pending.insert(*timeout);
+		}
+		_next_tick++;
+
+		while (Timeout *timeout = pending.first) {
+			pending.remove(*timeout);
+			if (timeout->_deadline_us > curr_us) {
+				_insert(*timeout);
+				continue;
+			}
+			_count--;
+			timeout->_handle_timeout(curr_time);
+		}
+	}
+	if (_next_tick <= curr_tick)
+		_next_tick = curr_tick + 1;
+
+	_timeout.discard();
+	if (!_count)
+		return;
+
+	for (uint64_t tick = _next_tick; tick < _next_tick + NR_OF_SLOTS; tick++) {
+		if (_slot(tick).first) {
+			_schedule_tick(tick);
+			return;
+		}
+	}
+}
+
+
+void Timeout_wheel::schedule(Timeout &timeout, Microseconds duration)
+{
+	uint64_t const curr_us { _curr_us() };
+	uint64_t const max_us  { ~(uint64_t)0 >> 1 };
+	uint64_t const deadline_us {
+		duration.value <= max_us - curr_us ? curr_us + duration.value : max_us };
+
+	if (timeout.scheduled()) {
+
+		/*
+		 * A later deadline is applied lazily when the wheel passes the
+		 * current slot of the timeout.
+		 */
+		if (deadline_us >= timeout._deadline_us) {
+			timeout._deadline_us = deadline_us;
+			return;
+		}
+		timeout._slot_ptr->remove(timeout);
+		_count--;
+	}
+	if (!_count && !_timeout.scheduled())
+		_next_tick = curr_us / _tick_us;
+
+	timeout._deadline_us = deadline_us;
+	_insert(timeout);
+	_count++;
+}
+
+
+void Timeout_wheel::discard(Timeout &timeout)
+{
+	if (!timeout.scheduled())
+		return;
+
+	timeout._slot_ptr->remove(timeout);
+	_count--;
+	if (!_count)
+		_timeout.discard();
+}
@@ -0,0 +1,161 @@
+/*
+ * \brief  Hashed timer wheel for large numbers of coarse-grained timeouts
+ * \author agent
+ * \date   2026-10-19
+ *
+ * NOTE: This implementation is not thread safe and should only be used in
+ *       single-threaded components.
+ *
+ * All timeouts of a wheel share one timer timeout. Each timeout is kept in
+ * the slot of the tick that its deadline rounds up to. Timeouts with a
+ * deadline beyond one wheel revolution stay in their slot until the wheel
+ * passes the slot for the right revolution. Moving a scheduled deadline to
+ * a later point in time only updates the deadline. The timeout is moved to
+ * the matching slot not before the wheel passes its current slot, which
+ * makes frequent re-scheduling (e.g., once per packet) cheap.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TIMEOUT_WHEEL_H_
+#define _TIMEOUT_WHEEL_H_
+
+/* local includes */
+#include <cached_timer.h>
+
+namespace Net {
+
+	class Timeout_wheel;
+	template <typename> class Wheel_timeout;
+}
+
+
+class Net::Timeout_wheel
+{
+	public:
+
+		class Timeout;
+
+	private:
+
+		using Duration     = Genode::Duration;
+		using Microseconds = Genode::Microseconds;
+		using uint64_t     = Genode::uint64_t;
+
+		enum { NR_OF_SLOTS = 512 };
+
+		struct Slot
+		{
+			Timeout *first { nullptr };
+
+			void insert(Timeout &timeout);
+
+			void remove(Timeout &timeout);
+		};
+
+		Cached_timer                             &_timer;
+		uint64_t                           const  _tick_us;
+		Timer::One_shot_timeout<Timeout_wheel>    _timeout;
+		Slot                                      _slots[NR_OF_SLOTS];
+		uint64_t                                  _next_tick      { 0 };
+		uint64_t                                  _scheduled_tick { 0 };
+		Genode::size_t                            _count          { 0 };
+
+		/*
+		 * Noncopyable
+		 */
+		Timeout_wheel(Timeout_wheel const &);
+		Timeout_wheel &operator = (Timeout_wheel const &);
+
+		uint64_t _curr_us() const {
+			return _timer.cached_time().trunc_to_plain_us().value; }
+
+		Slot &_slot(uint64_t tick) { return _slots[tick % NR_OF_SLOTS]; }
+
+		void _insert(Timeout &timeout);
+
+		void _schedule_tick(uint64_t tick);
+
+		void _handle_timeout(Duration);
+
+	public:
+
+		Timeout_wheel(Cached_timer &timer, Microseconds tick);
+
+		~Timeout_wheel();
+
+		void schedule(Timeout &timeout, Microseconds duration);
+
+		void discard(Timeout &timeout);
+};
+
+
+class Net::Timeout_wheel::Timeout
+{
+	friend class Timeout_wheel;
+
+	private:
+
+		Timeout_wheel    &_wheel;
+		Timeout          *_prev        { nullptr };
+		Timeout          *_next        { nullptr };
+		Slot             *_slot_ptr    { nullptr };
+		Genode::uint64_t  _deadline_us { 0 };
+
+		/*
+		 * Noncopyable
+		 */
+		Timeout(Timeout const &);
+		Timeout &operator = (Timeout const &);
+
+		virtual void _handle_timeout(Genode::Duration) = 0;
+
+	protected:
+
+		Timeout(Timeout_wheel &wheel) : _wheel(wheel) { }
+
+		virtual ~Timeout() { discard(); }
+
+	public:
+
+		void schedule(Genode::Microseconds duration) { _wheel.schedule(*this, duration); }
+
+		void discard() { _wheel.discard(*this); }
+
+		bool scheduled() const { return _slot_ptr != nullptr; }
+};
+
+
+/**
+ * Wheel timeout that is linked to a custom handler
+ */
+template <typename HANDLER>
+class Net::Wheel_timeout : public Timeout_wheel::Timeout
+{
+	private:
+
+		using Duration       = Genode::Duration;
+		using Handler_method = void (HANDLER::*)(Duration);
+
+		HANDLER              &_object;
+		Handler_method const  _method;
+
+		void _handle_timeout(Duration curr_time) override {
+			(_object.*_method)(curr_time); }
+
+	public:
+
+		Wheel_timeout(Timeout_wheel  &wheel,
+		              HANDLER        &object,
+		              Handler_method  method)
+		:
+			Timeout { wheel }, _object { object }, _method { method }
+		{ }
+};
+
+#endif /* _TIMEOUT_WHEEL_H_ */
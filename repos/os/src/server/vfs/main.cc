@@ -89,7 +89,6 @@ class Vfs_server::Session_component : private Session_resources,
 	private:
 
 		Vfs::File_system &_vfs;
-		Vfs::Env::Io     &_io;
 
 		Genode::Entrypoint &_ep;
 
@@ -121,6 +120,12 @@ class Vfs_server::Session_component : private Session_resources,
 
 		bool _stalled = false;
 
+		/* submit queue not drained because the job quantum was used up */
+		bool _quantum_exhausted = false;
+
+		/* acknowledgements not yet signalled to the client */
+		bool _wakeup_pending = false;
+
 
 		/****************************
 		 ** Handle to node mapping **
@@ -165,7 +170,7 @@ class Vfs_server::Session_component : private Session_resources,
 		 ** Packet-stream processing **
 		 ******************************/
 
-		bool _try_import_jobs_from_submit_queue()
+		bool _try_import_jobs_from_submit_queue(unsigned &quantum)
 		{
 			bool overall_progress = false;
 
@@ -176,6 +181,12 @@ class Vfs_server::Session_component : private Session_resources,
 				if (!_stream.packet_avail())
 					break;
 
+				/* leave remaining requests to the next scheduling round */
+				if (quantum == 0) {
+					_quantum_exhausted = true;
+					break;
+				}
+
 				/* ensure that ack for one malformed packet can be returned */
 				if (!_stream.ready_to_ack())
 					break;
@@ -185,6 +196,7 @@ class Vfs_server::Session_component : private Session_resources,
 				auto drop_packet_from_submit_queue = [&] ()
 				{
 					_stream.try_get_packet();
+					quantum--;
 
 					overall_progress      = true;
 					progress_in_iteration = true;
@@ -275,6 +287,7 @@ class Vfs_server::Session_component : private Session_resources,
 
 				if (node.acknowledgement_pending()) {
 					_stream.try_ack_packet(node.dequeue_acknowledgement());
+					_wakeup_pending = true;
 					progress = true;
 				}
 
@@ -299,15 +312,22 @@ class Vfs_server::Session_component : private Session_resources,
 		enum class Process_packets_result { NONE, PROGRESS, TOO_MUCH_PROGRESS };
 
 		/**
-		 * Called by the global Io_progress_handler as well as the
-		 * session-local packet-stream handler
+		 * Called by the global Io_progress_handler for each active session
+		 *
+		 * \param quantum  maximum number of requests to import from the
+		 *                 submit queue
+		 *
+		 * The acknowledgements are not signalled to the client before
+		 * 'wakeup' is called.
 		 *
 		 * \return true if progress was made
 		 */
-		Process_packets_result process_packets()
+		Process_packets_result process_packets(unsigned quantum)
 		{
 			bool overall_progress = false;
 
+			_quantum_exhausted = false;
+
 			/*
 			 * Upper bound for the number of iterations. When reached,
 			 * cancel the handler and trigger the re-execution via a local
@@ -325,7 +345,7 @@ class Vfs_server::Session_component : private Session_resources,
 				/* true if progress can be made in this iteration */
 				bool progress_in_iteration = false;
 
-				progress_in_iteration |= _try_import_jobs_from_submit_queue();
+				progress_in_iteration |= _try_import_jobs_from_submit_queue(quantum);
 
 				_execute_jobs();
 
@@ -337,8 +357,6 @@ class Vfs_server::Session_component : private Session_resources,
 				overall_progress |= progress_in_iteration;
 			}
 
-			_stream.wakeup();
-
 			return overall_progress ? Process_packets_result::PROGRESS
 			                        : Process_packets_result::NONE;
 		}
@@ -349,38 +367,39 @@ class Vfs_server::Session_component : private Session_resources,
 		 */
 		bool no_longer_active() const
 		{
-			return _active_nodes.empty() && !_stalled;
+			return _active_nodes.empty() && !_stalled && !_quantum_exhausted;
 		}
 
-		bool no_longer_idle() const
+		/**
+		 * Signal the acknowledgements of all preceding 'process_packets'
+		 * calls to the client at once
+		 */
+		void wakeup()
 		{
-			return !Session_queue::Element::enqueued() && !_active_nodes.empty();
+			if (!_wakeup_pending)
+				return;
+
+			_wakeup_pending = false;
+			_stream.wakeup();
 		}
 
 	private:
 
 		/**
 		 * Signal handler called for session-local packet-stream signals
+		 *
+		 * The packets are not processed here but by the global
+		 * 'Io_progress_handler', which serves all active sessions in
+		 * round-robin fashion. This way, a client that keeps its submit
+		 * queue saturated cannot delay the requests of other sessions by
+		 * more than one job quantum per round.
 		 */
 		void _handle_packet_stream()
 		{
-			Process_packets_result const progress = process_packets();
-
-			if (no_longer_idle() || _stalled)
+			if (!enqueued())
 				_active_sessions.enqueue(*this);
 
-			if (progress == Process_packets_result::TOO_MUCH_PROGRESS)
-				Genode::Signal_transmitter(_packet_stream_handler).submit();
-
-			/*
-			 * The activity of the session may have an unblocking effect on
-			 * other sessions. So we call the global 'Io_progress_handler' to
-			 * attempt the packet processing of all active sessions.
-			 */
-			if (progress == Process_packets_result::PROGRESS)
-				_io_progress_handler.handle_io_progress();
-
-			_io.commit();
+			_io_progress_handler.handle_io_progress();
 		}
 
 		/**
@@ -445,7 +464,6 @@ class Vfs_server::Session_component : private Session_resources,
 		                  Genode::Cap_quota    cap_quota,
 		                  size_t               tx_buf_size,
 		                  Vfs::File_system    &vfs,
-		                  Vfs::Env::Io        &io,
 		                  Session_queue       &active_sessions,
 		                  Io_progress_handler &io_progress_handler,
 		                  char          const *root_path,
@@ -454,7 +472,6 @@ class Vfs_server::Session_component : private Session_resources,
 			Session_resources(env.ram(), env.rm(), ram_quota, cap_quota, tx_buf_size),
 			Session_rpc_object(_packet_ds.cap(), env.rm(), env.ep().rpc_ep()),
 			_vfs(vfs),
-			_io(io),
 			_ep(env.ep()),
 			_io_progress_handler(io_progress_handler),
 			_active_sessions(active_sessions),
@@ -780,9 +797,21 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 		Genode::Signal_handler<Root> _config_handler {
 			_env.ep(), *this, &Root::_config_update };
 
+		/*
+		 * Maximum number of requests imported per session and scheduling
+		 * round, which bounds the delay a busy session imposes on others
+		 */
+		unsigned _quantum = 0;
+
+		void _update_quantum()
+		{
+			_quantum = Genode::max(_config_rom.xml().attribute_value("quantum", 32u), 1u);
+		}
+
 		void _config_update()
 		{
 			_config_rom.update();
+			_update_quantum();
 			_config_rom.xml().with_optional_sub_node("vfs", [&] (Xml_node const &config) {
 				_vfs_env.root_dir().apply_config(config); });
 
@@ -829,7 +858,7 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 
 					using Result = Session_component::Process_packets_result;
 
-					switch (session.process_packets()) {
+					switch (session.process_packets(_quantum)) {
 
 					case Result::PROGRESS:
 						progress = true;
@@ -843,7 +872,9 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 						break;
 					}
 
-					if (!session.no_longer_active())
+					if (session.no_longer_active())
+						session.wakeup();
+					else
 						still_active_sessions.enqueue(session);
 				});
 
@@ -860,6 +891,10 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 			if (yield)
 				Genode::Signal_transmitter(_reactivate_handler).submit();
 
+			/* signal the acknowledgements of all rounds at once */
+			_active_sessions.for_each([&] (Session_component &session) {
+				session.wakeup(); });
+
 			_vfs_env.io().commit();
 		}
 
@@ -952,7 +987,6 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 				                  Genode::Ram_quota{ram_quota},
 				                  Genode::Cap_quota{cap_quota},
 				                  tx_buf_size, _vfs_env.root_dir(),
-				                  _vfs_env.io(),
 				                  _active_sessions, *this,
 				                  session_root.base(), writeable);
 
@@ -997,6 +1031,7 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 			Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
 			_env(env)
 		{
+			_update_quantum();
 			_env.ep().register_io_progress_handler(*this);
 			_config_rom.sigh(_config_handler);
 			env.parent().announce(env.ep().manage(*this));
@@ -0,0 +1,206 @@
+/*
+ * \brief  Correctness and throughput test for packet-stream allocators
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The test fills a packet buffer with single-block packets, frees a random
+ * share of them, and then measures alloc/free cycles of mixed-size packets
+ * for the plain bitmap 'Packet_allocator' and the
+ * 'Hierarchical_packet_allocator'. The buffer thereby stays highly occupied
+ * and fragmented, which is the case where the search for free blocks
+ * dominates. The buffer memory is never touched, so a fake range base
+ * suffices.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <os/packet_allocator.h>
+#include <os/hierarchical_packet_allocator.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Random
+{
+	uint64_t _state;
+
+	uint32_t next()
+	{
+		/* xorshift64 */
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+		return (uint32_t)_state;
+	}
+};
+
+
+template <typename ALLOC>
+struct Packet_allocator_test
+{
+	enum {
+		BLOCK_SIZE  = 512,
+		NUM_BLOCKS  = 16*1024,
+		NUM_SLOTS   = NUM_BLOCKS,
+		NUM_ROUNDS  = 200*1000,
+		RANGE_BASE  = 0x10000000,
+	};
+
+	struct Packet { addr_t addr; size_t size; };
+
+	Allocator        &_heap;
+	Timer::Connection &_timer;
+	char const *const _name;
+	ALLOC             _alloc    { &_heap, BLOCK_SIZE };
+	uint8_t          *_owner    { (uint8_t *)_heap.alloc(NUM_BLOCKS) };
+	Packet           *_packets  { (Packet *)_heap.alloc(NUM_SLOTS*sizeof(Packet)) };
+	unsigned          _num_packets { 0 };
+	Random            _random   { 0x2545f4914f6cdd1dULL };
+	bool              _failed   { false };
+
+	/*
+	 * Noncopyable
+	 */
+	Packet_allocator_test(Packet_allocator_test const &);
+	Packet_allocator_test &operator = (Packet_allocator_test const &);
+
+	size_t _random_size()
+	{
+		/* mostly MTU-sized packets, sometimes large multi-block packets */
+		if (_random.next() % 16 == 0)
+			return 1 + _random.next() % (16*BLOCK_SIZE);
+
+		return 64 + _random.next() % 1536;
+	}
+
+	static size_t _blocks(size_t size) { return (size + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+	void _mark(Packet const &packet, uint8_t value)
+	{
+		size_t const first = (packet.addr - RANGE_BASE) / BLOCK_SIZE;
+		size_t const cnt   = _blocks(packet.size);
+		if ((packet.addr - RANGE_BASE) % BLOCK_SIZE || first + cnt > NUM_BLOCKS) {
+			error(_name, ": packet out of range");
+			_failed = true;
+			return;
+		}
+		for (size_t idx = first; idx < first + cnt; idx++) {
+			if (_owner[idx] == value) {
+				error(_name, ": ", value ? "overlapping" : "double-freed", " packet");
+				_failed = true;
+			}
+			_owner[idx] = value;
+		}
+	}
+
+	bool _alloc_packet(size_t size, bool check)
+	{
+		return _alloc.try_alloc(size).template convert<bool>(
+			[&] (Allocator::Allocation &a) {
+				a.deallocate = false;
+				Packet const packet { (addr_t)a.ptr, size };
+				if (check)
+					_mark(packet, 1);
+
+				_packets[_num_packets++] = packet;
+				return true;
+			},
+			[&] (Alloc_error) { return false; });
+	}
+
+	void _free_packet(unsigned idx, bool check)
+	{
+		Packet const packet = _packets[idx];
+		_packets[idx] = _packets[--_num_packets];
+		if (check)
+			_mark(packet, 0);
+
+		_alloc.free((void *)packet.addr, packet.size);
+	}
+
+	void _run_rounds(unsigned rounds, bool check)
+	{
+		/* each round allocates one packet and frees a random one */
+		for (unsigned round = 0; round < rounds; round++) {
+			if (_num_packets < NUM_SLOTS)
+				_alloc_packet(_random_size(), check);
+
+			if (_num_packets)
+				_free_packet(_random.next() % _num_packets, check);
+		}
+	}
+
+	Packet_allocator_test(Allocator &heap, Timer::Connection &timer, char const *name)
+	:
+		_heap(heap), _timer(timer), _name(name)
+	{
+		memset(_owner, 0, NUM_BLOCKS);
+		if (_alloc.add_range(RANGE_BASE, NUM_BLOCKS*BLOCK_SIZE).failed()) {
+			error(_name, ": failed to add range");
+			_failed = true;
+			return;
+		}
+		/* fill the buffer and punch holes of single blocks into it */
+		while (_num_packets < NUM_SLOTS && _alloc_packet(BLOCK_SIZE, true));
+		for (unsigned idx = 0; idx < NUM_BLOCKS / 8 && _num_packets; idx++)
+			_free_packet(_random.next() % _num_packets, true);
+
+		/* verify the allocator against the ownership map */
+		_run_rounds(NUM_ROUNDS / 10, true);
+
+		/* measure */
+		uint64_t const start_us = _timer.elapsed_us();
+		_run_rounds(NUM_ROUNDS, false);
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, (uint64_t)1);
+
+		log(_name, ": ", (uint64_t)NUM_ROUNDS, " operations in ", duration_us, " us (",
+		    ((uint64_t)NUM_ROUNDS * 1000) / duration_us, " operations/ms)");
+	}
+
+	~Packet_allocator_test()
+	{
+		while (_num_packets)
+			_free_packet(0, false);
+
+		_heap.free(_packets, NUM_SLOTS*sizeof(Packet));
+		_heap.free(_owner, NUM_BLOCKS);
+		(void)_alloc.remove_range(RANGE_BASE, NUM_BLOCKS*BLOCK_SIZE);
+	}
+
+	bool failed() const { return _failed; }
+};
+
+
+void Component::construct(Env &env)
+{
+	static Heap              heap  { env.ram(), env.rm() };
+	static Timer::Connection timer { env };
+
+	log("--- packet allocator test ---");
+
+	bool failed = false;
+	{
+		Packet_allocator_test<Packet_allocator> test { heap, timer, "bitmap" };
+		failed |= test.failed();
+	}
+	{
+		Packet_allocator_test<Hierarchical_packet_allocator> test { heap, timer, "hierarchical" };
+		failed |= test.failed();
+	}
+	if (failed) {
+		error("packet allocator test failed");
+		env.parent().exit(-1);
+		return;
+	}
+	log("Test done");
+	env.parent().exit(0);
+}
@@ -0,0 +1,226 @@
+/*
+ * \brief  Throughput test for the storage backends of the VFS ram plugin
+ * \author agent
+ * \date   2026-10-19
+ *
+ * The test performs the same sequence of sequential and random I/O on a
+ * file of each configured '<ram>' file system, compares the resulting file
+ * content, and measures the export of the file content as dataspace.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_dataspace.h>
+#include <timer_session/connection.h>
+#include <vfs/simple_env.h>
+
+using namespace Genode;
+
+
+struct Random
+{
+	uint64_t _state;
+
+	uint32_t next()
+	{
+		/* xorshift64 */
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+		return (uint32_t)_state;
+	}
+};
+
+
+struct Test_failed : Exception { };
+
+
+struct Ram_test
+{
+	enum {
+		SEQ_BLOCK_SIZE  = 64*1024,
+		RAND_BLOCK_SIZE = 4096,
+		NUM_RAND_OPS    = 16*1024,
+	};
+
+	using Path = String<Vfs::MAX_PATH_LEN>;
+
+	Env               &_env;
+	Allocator         &_alloc;
+	Vfs::File_system  &_vfs;
+	Timer::Connection &_timer;
+	Path         const _path;
+	size_t       const _file_size;
+	char              *_buf;
+	Vfs::Vfs_handle   *_handle = nullptr;
+
+	/*
+	 * Noncopyable
+	 */
+	Ram_test(Ram_test const &);
+	Ram_test &operator = (Ram_test const &);
+
+	void _write(Vfs::file_size at, char const *src, size_t len)
+	{
+		_handle->seek(at);
+
+		size_t out = 0;
+		if (_vfs.write(_handle, Const_byte_range_ptr(src, len), out)
+		    != Vfs::File_io_service::WRITE_OK || out != len) {
+			error(_path, ": write of ", len, " bytes at ", at, " failed");
+			throw Test_failed();
+		}
+	}
+
+	void _read(Vfs::file_size at, char *dst, size_t len)
+	{
+		_handle->seek(at);
+
+		size_t out = 0;
+		if (!_vfs.queue_read(_handle, len)
+		 || _vfs.complete_read(_handle, Byte_range_ptr(dst, len), out)
+		    != Vfs::File_io_service::READ_OK || out != len) {
+			error(_path, ": read of ", len, " bytes at ", at, " failed");
+			throw Test_failed();
+		}
+	}
+
+	template <typename FN>
+	void _measure(char const *what, size_t bytes, FN const &fn)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+		fn();
+		uint64_t const duration_us = max(_timer.elapsed_us() - start_us, (uint64_t)1);
+
+		log(_path, ": ", what, " ", bytes/1024, " KiB in ", duration_us, " us (",
+		    (bytes*1000*1000/1024/1024) / duration_us, " MiB/s)");
+	}
+
+	Vfs::file_size _random_block(Random &random) const
+	{
+		return (random.next() % (_file_size / RAND_BLOCK_SIZE))*RAND_BLOCK_SIZE;
+	}
+
+	Ram_test(Env &env, Allocator &alloc, Vfs::File_system &vfs,
+	         Timer::Connection &timer, Path const &path, size_t file_size)
+	:
+		_env(env), _alloc(alloc), _vfs(vfs), _timer(timer), _path(path),
+		_file_size(file_size), _buf((char *)alloc.alloc(SEQ_BLOCK_SIZE))
+	{
+		using Open_result = Vfs::Directory_service::Open_result;
+
+		if (_vfs.open(_path.string(), Vfs::Directory_service::OPEN_MODE_RDWR |
+		                              Vfs::Directory_service::OPEN_MODE_CREATE,
+		              &_handle, _alloc) != Open_result::OPEN_OK) {
+			error(_path, ": open failed");
+			throw Test_failed();
+		}
+
+		_measure("sequential write", _file_size, [&] {
+			for (size_t at = 0; at < _file_size; at += SEQ_BLOCK_SIZE) {
+				memset(_buf, (uint8_t)(at / SEQ_BLOCK_SIZE), SEQ_BLOCK_SIZE);
+				_write(at, _buf, SEQ_BLOCK_SIZE);
+			}
+		});
+
+		_measure("sequential read", _file_size, [&] {
+			for (size_t at = 0; at < _file_size; at += SEQ_BLOCK_SIZE)
+				_read(at, _buf, SEQ_BLOCK_SIZE);
+		});
+
+		Random random { 0x2545f4914f6cdd1dULL };
+
+		_measure("random write", NUM_RAND_OPS*RAND_BLOCK_SIZE, [&] {
+			for (unsigned i = 0; i < NUM_RAND_OPS; i++) {
+				memset(_buf, (uint8_t)i, RAND_BLOCK_SIZE);
+				_write(_random_block(random), _buf, RAND_BLOCK_SIZE);
+			}
+		});
+
+		_measure("random read", NUM_RAND_OPS*RAND_BLOCK_SIZE, [&] {
+			for (unsigned i = 0; i < NUM_RAND_OPS; i++)
+				_read(_random_block(random), _buf, RAND_BLOCK_SIZE);
+		});
+	}
+
+	~Ram_test()
+	{
+		_handle->close();
+		_alloc.free(_buf, SEQ_BLOCK_SIZE);
+	}
+
+	/**
+	 * Export file content as dataspace and call 'fn' with its local address
+	 */
+	template <typename FN>
+	void with_dataspace(FN const &fn)
+	{
+		Dataspace_capability ds_cap { };
+
+		_measure("dataspace export", _file_size, [&] {
+			ds_cap = _vfs.dataspace(_path.string()); });
+
+		if (!ds_cap.valid()) {
+			error(_path, ": dataspace export failed");
+			throw Test_failed();
+		}
+		{
+			Attached_dataspace ds { _env.rm(), ds_cap };
+			if (ds.size() < _file_size) {
+				error(_path, ": exported dataspace too small");
+				throw Test_failed();
+			}
+			fn(ds.local_addr<char const>());
+		}
+		_vfs.release(_path.string(), ds_cap);
+	}
+};
+
+
+void Component::construct(Env &env)
+{
+	static Heap              heap   { env.ram(), env.rm() };
+	static Timer::Connection timer  { env };
+	static Attached_rom_dataspace config { env, "config" };
+
+	Xml_node const config_xml = config.xml();
+
+	static Vfs::Simple_env vfs_env { env, heap, config_xml.sub_node("vfs") };
+
+	size_t const file_size =
+		config_xml.attribute_value("file_size", Number_of_bytes(32*1024*1024));
+
+	log("--- VFS ram test ---");
+
+	try {
+		Ram_test chunk  { env, heap, vfs_env.root_dir(), timer, "/chunk/file",  file_size };
+		Ram_test extent { env, heap, vfs_env.root_dir(), timer, "/extent/file", file_size };
+
+		/* both backends must hold the same content */
+		chunk.with_dataspace([&] (char const *expected) {
+			extent.with_dataspace([&] (char const *content) {
+				if (memcmp(expected, content, file_size)) {
+					error("file content differs between backends");
+					throw Test_failed();
+				}
+			});
+		});
+	}
+	catch (Test_failed) {
+		error("VFS ram test failed");
+		env.parent().exit(-1);
+		return;
+	}
+
+	log("Test done");
+	env.parent().exit(0);
+}